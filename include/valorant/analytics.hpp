@@ -1,37 +1,229 @@
 #pragma once
 
+#include "valorant/arena.hpp"
+#include "valorant/cache.hpp"
+#include "valorant/changepoint.hpp"
+#include "valorant/match_table.hpp"
+#include "valorant/quantile_sketch.hpp"
+#include "valorant/thread_pool.hpp"
 #include "valorant/types.hpp"
+#include <chrono>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace valorant {
 
+// Each per-match analysis has a MatchTable overload that does the work; the
+// PlayerMatchSummary overloads convert and delegate.
+
+std::vector<HourlyPerformance> performance_by_hour(const MatchTable& table);
 std::vector<HourlyPerformance> performance_by_hour(
     const std::vector<PlayerMatchSummary>& matches);
 
+WeekHourHeatmap performance_by_weekday_hour(const MatchTable& table);
+WeekHourHeatmap performance_by_weekday_hour(
+    const std::vector<PlayerMatchSummary>& matches);
+
+std::vector<SessionPerformance> performance_by_session(
+    const MatchTable& table, const std::vector<Session>& sessions);
 std::vector<SessionPerformance> performance_by_session(
-    const std::vector<Session>& sessions);
+    const std::vector<PlayerMatchSummary>& matches, const std::vector<Session>& sessions);
 
 std::vector<SessionPerformance> rr_by_session(
-    const std::vector<Session>& sessions);
+    const MatchTable& table, const std::vector<Session>& sessions);
+std::vector<SessionPerformance> rr_by_session(
+    const std::vector<PlayerMatchSummary>& matches, const std::vector<Session>& sessions);
 
-std::vector<RollingMetric> rolling_kda(
+RollingSeries rolling_kda(const MatchTable& table, int window = 20);
+RollingSeries rolling_kda(
     const std::vector<PlayerMatchSummary>& matches, int window = 20);
 
-std::vector<RollingMetric> rolling_win_rate(
+RollingSeries rolling_win_rate(const MatchTable& table, int window = 20);
+RollingSeries rolling_win_rate(
     const std::vector<PlayerMatchSummary>& matches, int window = 20);
 
+// Rolling means for every combination of `stats` and `windows` in a single
+// O(n * stats * windows) pass using running sums, independent of window size.
+RollingSet rolling_metrics(const MatchTable& table,
+                           std::span<const RollingStat> stats,
+                           std::span<const int> windows);
+
+// Id of the match whose window produced series[i].
+inline const MatchId& rolling_match_id(const MatchTable& table,
+                                       const RollingSeries& series, std::size_t i) {
+    return table.match_id[series.match_index(i)];
+}
+
+// Streaming per-position KDA statistics (count, sum, sum of squares) behind
+// decay_curve. Memory is O(positions), and accumulators built for different
+// players or on different threads can be merged.
+class DecayAccumulator {
+public:
+    // With track_quantiles, each position also keeps a KDA sketch and fit()
+    // fills point_quantiles. Off by default: bootstrap replicates only need
+    // the sums.
+    explicit DecayAccumulator(bool track_quantiles = false);
+
+    void add(int position, double kda); // position is 1-based
+    void add_session(const MatchTable& table, const Session& session);
+    void merge(const DecayAccumulator& other);
+
+    // PositionMeans fits a line through the per-position averages, treating
+    // each position equally; Samples fits every game, so well-populated
+    // positions carry proportionally more weight.
+    DecayCurveModel fit(DecayWeighting weighting = DecayWeighting::PositionMeans) const;
+
+private:
+    struct Position {
+        std::int64_t count = 0;
+        double sum = 0.0;
+        double sum_sq = 0.0;
+    };
+
+    bool track_quantiles_;
+    std::vector<Position> positions_;
+    std::vector<QuantileSketch> sketches_;
+};
+
 DecayCurveModel decay_curve(
-    const std::vector<Session>& sessions, int min_session_length = 3);
+    const MatchTable& table, const std::vector<Session>& sessions,
+    int min_session_length = 3,
+    DecayWeighting weighting = DecayWeighting::PositionMeans);
+DecayCurveModel decay_curve(
+    const std::vector<PlayerMatchSummary>& matches, const std::vector<Session>& sessions,
+    int min_session_length = 3,
+    DecayWeighting weighting = DecayWeighting::PositionMeans);
 
+std::vector<AgentPerformance> performance_by_agent(const MatchTable& table);
 std::vector<AgentPerformance> performance_by_agent(
     const std::vector<PlayerMatchSummary>& matches);
 
+std::vector<MapPerformance> performance_by_map(const MatchTable& table);
 std::vector<MapPerformance> performance_by_map(
     const std::vector<PlayerMatchSummary>& matches);
 
+// The cross-tab from aggregate_matches, whose single pass fills a dense
+// agents x maps grid next to the per-agent and per-map accumulators that give
+// its marginals. Call aggregate_matches directly when the rest is needed too.
+AgentMapCrossTab agent_map_crosstab(const MatchTable& table);
+AgentMapCrossTab agent_map_crosstab(const std::vector<PlayerMatchSummary>& matches);
+
+OverviewStats compute_overview(
+    const MatchTable& table,
+    const std::vector<AgentPerformance>& agents,
+    const std::vector<MapPerformance>& maps);
 OverviewStats compute_overview(
     const std::vector<PlayerMatchSummary>& matches,
     const std::vector<AgentPerformance>& agents,
     const std::vector<MapPerformance>& maps);
 
+// Session count, mean session length and decay slope for each gap threshold,
+// returned in ascending threshold order. The inter-match gaps are sorted once;
+// raising the threshold only joins neighbouring sessions, and a joined
+// session's regression sums follow from its halves in O(1), so the whole
+// sweep costs O(n log n + k) instead of k separate detect_sessions runs. The
+// slope is the per-game fit, since per-position means do not merge in O(1).
+std::vector<GapSweepPoint> sweep_gap_thresholds(
+    const MatchTable& table, std::span<const int> gap_minutes, int min_session_length = 3);
+
+// Overview, hourly, weekday x hour, agent, map and agent x map breakdowns plus
+// rolling KDA and win rate.
+// The serial overload does all of it in a single pass over the table. The
+// pool overload reduces chunks on workers while one more task runs the
+// rolling scan, which cannot be split. Rows are reduced in fixed-size
+// chunks merged in order, so the pool overload returns bit-identical results
+// to the serial one; for tables under one chunk both also match the
+// individual calls exactly. Must not be called from a task on `pool`.
+MatchAggregates aggregate_matches(const MatchTable& table, int window = 20);
+MatchAggregates aggregate_matches(const MatchTable& table, int window, ThreadPool& pool);
+
+struct ReportData {
+    // Backs the per-game vectors below; declared first so it is destroyed last
+    std::unique_ptr<Arena> arena;
+    PlayerIdentity player;
+    int match_count = 0;
+    OverviewStats overview;
+    std::vector<HourlyPerformance> hourly;
+    WeekHourHeatmap heatmap;
+    std::vector<SessionPerformance> sessions;
+    std::vector<SessionPerformance> rr_sessions;
+    RollingSeries rolling_kda;
+    RollingSeries rolling_wr;
+    TiltAnalysis tilt; // changepoints of the per-match KDA, win and RR series
+    DecayCurveModel decay;
+    std::vector<AgentPerformance> agents;
+    std::vector<MapPerformance> maps;
+    AgentMapCrossTab crosstab;
+    std::vector<GapSweepPoint> gap_sweep; // ascending thresholds
+    int gap_minutes = 45;                 // threshold the other tabs use
+    int min_session_length = 3;           // shortest session counted in decay fits
+    CacheStats cache_stats;
+};
+
+// Report state that absorbs new matches without revisiting history: group,
+// hour and overview accumulators, rolling window buffers, the open session
+// and per-position decay sums. Ingesting k matches costs O(k). Counts, means
+// and rates equal the batch function over all matches ingested so far. So do
+// quantile bands while the history fits in one reduction chunk (16384 rows);
+// past that the batch pass merges per-chunk sketches, which compress
+// differently, and the bands agree only to sketch accuracy.
+class AnalyticsState {
+public:
+    explicit AnalyticsState(int window = 20,
+                            std::chrono::minutes gap_threshold = std::chrono::minutes(45),
+                            int min_session_length = 3);
+    ~AnalyticsState();
+    AnalyticsState(AnalyticsState&&) noexcept;
+    AnalyticsState& operator=(AnalyticsState&&) noexcept;
+
+    // Rows [from, table.size()), which must be newer than anything ingested.
+    void ingest(const MatchTable& table, std::size_t from = 0);
+    void ingest(const std::vector<PlayerMatchSummary>& matches);
+
+    std::size_t match_count() const;
+    OverviewStats overview() const;
+    std::vector<HourlyPerformance> hourly() const;
+    WeekHourHeatmap heatmap() const;
+    std::vector<AgentPerformance> agents() const;
+    std::vector<MapPerformance> maps() const;
+    const RollingSeries& rolling_kda() const;
+    const RollingSeries& rolling_wr() const;
+    const std::vector<SessionPerformance>& sessions() const;
+    DecayCurveModel decay(DecayWeighting weighting = DecayWeighting::PositionMeans) const;
+
+    // Everything the state accumulates, with sessions as both the KDA and RR
+    // breakdowns. The arena, player, tilt, gap sweep, bootstrap and cache
+    // stats need the full table or outside state, so the caller fills them.
+    ReportData report(DecayWeighting weighting = DecayWeighting::PositionMeans) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// Hourly, weekday x hour, agent and map accumulators that merge across tables, so results
+// computed per player (on separate threads) pool into one cohort breakdown.
+// add() reduces the table exactly as aggregate_matches does.
+class BreakdownAccumulator {
+public:
+    BreakdownAccumulator();
+    ~BreakdownAccumulator();
+    BreakdownAccumulator(BreakdownAccumulator&&) noexcept;
+    BreakdownAccumulator& operator=(BreakdownAccumulator&&) noexcept;
+
+    void add(const MatchTable& table);
+    void merge(const BreakdownAccumulator& other);
+
+    std::size_t match_count() const;
+    std::vector<HourlyPerformance> hourly() const;
+    WeekHourHeatmap heatmap() const;
+    std::vector<AgentPerformance> agents() const;
+    std::vector<MapPerformance> maps() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 } // namespace valorant
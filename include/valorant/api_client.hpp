@@ -20,9 +20,14 @@ std::expected<PlayerIdentity, ApiError> fetch_account(
     const std::string& name, const std::string& tag);
 
 std::expected<std::vector<PlayerMatchSummary>, ApiError> fetch_stored_matches(
-    const ClientConfig& config, RateLimiter& limiter,
+    const ClientConfig& config, RateLimiter& limiter, Cache& cache,
     const std::string& region, const std::string& name, const std::string& tag,
-    int count = 200, ProgressCallback on_progress = nullptr);
+    const std::string& puuid, int count = 200, ProgressCallback on_progress = nullptr);
+
+// Rebuilds a player's match list from the cache alone, sorted by start time.
+// Matches are read CacheRead::Transient, so bulk loads leave the memory tier alone.
+std::vector<PlayerMatchSummary> load_cached_matches(
+    const Cache& cache, const std::string& puuid);
 
 std::expected<std::vector<MmrHistoryEntry>, ApiError> fetch_mmr_history(
     const ClientConfig& config, RateLimiter& limiter, Cache& cache,
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace valorant {
+
+// Bump allocator scoped to one player analysis. Containers built on
+// resource() never free individually; everything is released at once when
+// the arena is destroyed, so it must outlive every container using it.
+class Arena {
+public:
+    explicit Arena(std::size_t initial_size = 64 * 1024) : buffer_(initial_size) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &buffer_; }
+
+private:
+    std::pmr::monotonic_buffer_resource buffer_;
+};
+
+} // namespace valorant
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "valorant/match_table.hpp"
+#include "valorant/thread_pool.hpp"
+#include "valorant/types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace valorant {
+
+struct BootstrapOptions {
+    int replicates = 2000;
+    double confidence = 0.95; // must lie in (0, 1)
+    std::uint64_t seed = 0x5eed;
+    int min_session_length = 3;
+    DecayWeighting weighting = DecayWeighting::PositionMeans;
+};
+
+// Resamples qualifying sessions with replacement and refits the decay slope
+// for each replicate, spread across `pool`. Random draws come from a
+// counter-based generator keyed by (seed, replicate, draw), so the result
+// depends only on the inputs and seed, never on thread count or scheduling.
+// Nothing is computed (replicates == 0) for a confidence outside (0, 1).
+// Must not be called from a task on `pool`.
+DecayBootstrap bootstrap_decay_slope(const MatchTable& table,
+                                     const std::vector<Session>& sessions,
+                                     const BootstrapOptions& options,
+                                     ThreadPool& pool);
+
+} // namespace valorant
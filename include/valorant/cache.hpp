@@ -1,30 +1,167 @@
 #pragma once
 
+#include "valorant/cache_bundle.hpp"
+#include "valorant/cache_index.hpp"
+#include <array>
 #include <chrono>
 #include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 namespace valorant {
 
+struct CacheVerifyReport {
+    int scanned = 0;
+    int ok = 0;
+    int legacy = 0; // unframed JSON written by older builds, still readable
+    int corrupt = 0;
+    std::vector<std::pair<std::string, int>> corrupt_by_namespace; // every namespace, stats() order
+    std::vector<std::filesystem::path> corrupt_files;
+};
+
+// Log2 buckets of microseconds: bucket i counts samples in [2^(i-1), 2^i).
+struct LatencyHistogram {
+    static constexpr int bucket_count = 24;
+    std::array<std::uint64_t, bucket_count> buckets{};
+    std::uint64_t samples = 0;
+    std::uint64_t total_us = 0;
+
+    double mean_us() const { return samples ? static_cast<double>(total_us) / samples : 0.0; }
+    // Upper bound of the bucket holding the q-th quantile.
+    std::uint64_t percentile_us(double q) const;
+};
+
+struct NamespaceStats {
+    std::string name;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t expired = 0; // TTL expiries, also counted as misses
+    std::uint64_t corrupt = 0; // records failing the length, CRC or JSON check; also misses
+    std::uint64_t bytes_read = 0;
+    std::uint64_t bytes_written = 0;
+    std::uint64_t writes = 0;
+    LatencyHistogram read_latency;
+    LatencyHistogram write_latency;
+    std::uint64_t lookups() const { return hits + misses; }
+    double hit_rate() const { return lookups() ? static_cast<double>(hits) / lookups() : 0.0; }
+};
+
+struct CacheStats {
+    std::vector<NamespaceStats> namespaces; // matches, mmr_history, players
+};
+
+// Whether a read fills the memory tier. Bulk scans read Transient, so one
+// pass over many records does not evict the entries a report keeps reusing.
+enum class CacheRead { Retain, Transient };
+
+// File-based JSON cache. Several processes may share one directory: writes
+// are serialized by an advisory lock and land via atomic rename, and a
+// shared mmap'd index (data/index.bin) makes each write visible to every
+// other process without rescanning directories. Parsed records are also
+// kept in a least-recently-used memory tier of at most `memory_entries`.
 class Cache {
 public:
-    explicit Cache(std::filesystem::path base_dir = "data");
+    explicit Cache(std::filesystem::path base_dir = "data", std::size_t memory_entries = 1024);
+    ~Cache();
 
-    std::optional<nlohmann::json> get_match(const std::string& match_id) const;
+    std::optional<nlohmann::json> get_match(const std::string& match_id,
+                                            CacheRead mode = CacheRead::Retain) const;
     void store_match(const std::string& match_id, const nlohmann::json& data);
+    // Whether a local record exists, without reading it. Answered from the
+    // shared index when it is authoritative.
+    bool has_match(const std::string& match_id) const;
 
     std::optional<nlohmann::json> get_mmr_history(const std::string& puuid) const;
     void store_mmr_history(const std::string& puuid, const nlohmann::json& data);
 
+    // Ids of every match cached for a player, oldest first.
+    std::optional<std::vector<std::string>> get_player_matches(const std::string& puuid) const;
+    void store_player_matches(const std::string& puuid, const std::vector<std::string>& match_ids);
+
+    // Adds ids not already in the player's index, atomically with respect to
+    // other processes doing the same.
+    void append_player_matches(const std::string& puuid, const std::vector<std::string>& match_ids);
+
+    // Puuids whose match index was written most recently, newest first.
+    std::vector<std::string> recent_players(std::size_t count) const;
+
+    // Parses each player's MMR history and match index on a thread pool into
+    // the memory tier, then the matches those indexes list (newest first,
+    // while the tier has room), so the first lookups after a restart do not
+    // touch disk. Returns the number of records loaded.
+    std::size_t warm_up(const std::vector<std::string>& puuids) const;
+
+    // Checks the framing and checksum of every cached record in parallel, after
+    // rebuilding the shared index from the files on disk.
+    CacheVerifyReport verify() const;
+
+    // Snapshot of per-namespace counters since this Cache was created.
+    CacheStats stats() const;
+
+    // Packs every valid record into one compressed bundle. Returns the number
+    // of records written, or nullopt if the bundle could not be written.
+    std::optional<std::size_t> export_bundle(const std::filesystem::path& file) const;
+
+    // Copies bundle records into this cache without overwriting newer local
+    // records; player match indexes are merged. Returns records imported.
+    std::optional<std::size_t> import_bundle(const std::filesystem::path& file);
+
+    // Serves records missing from disk out of a read-only, mmap'd bundle.
+    bool attach_bundle(const std::filesystem::path& file);
+
 private:
+    struct Counters;
+
+    struct MemoryEntry {
+        nlohmann::json data;
+        std::filesystem::file_time_type written;
+        std::uint64_t seq = 0; // index version the data was read at
+    };
+
     std::filesystem::path base_dir_;
     static constexpr auto mmr_ttl_ = std::chrono::minutes(30);
+    static constexpr std::uint32_t index_capacity_ = 1u << 17; // initial; the index grows
+
+    std::unique_ptr<SharedIndex> index_;
+    std::unique_ptr<Counters> counters_;
+    std::unique_ptr<CacheBundle> bundle_;
+
+    // LRU order, most recent first; memory_ indexes it by "ns/key"
+    using MemoryList = std::list<std::pair<std::string, MemoryEntry>>;
+    std::size_t memory_capacity_;
+    mutable std::mutex memory_mutex_;
+    mutable MemoryList memory_lru_;
+    mutable std::unordered_map<std::string, MemoryList::iterator> memory_;
+
+    std::filesystem::path record_path(std::string_view ns, const std::string& key) const;
+
+    std::optional<nlohmann::json> read_json(std::string_view ns, const std::string& key,
+                                            std::optional<std::chrono::minutes> ttl = std::nullopt,
+                                            CacheRead mode = CacheRead::Retain) const;
+    std::optional<nlohmann::json> load_json(std::string_view ns, const std::string& key,
+                                            std::optional<std::chrono::minutes> ttl, CacheRead mode,
+                                            bool& was_expired, bool& was_corrupt,
+                                            std::uint64_t& bytes_read) const;
+    void write_json(std::string_view ns, const std::string& key, const nlohmann::json& data) const;
+    void write_json_locked(std::string_view ns, const std::string& key, const nlohmann::json& data,
+                           std::optional<std::filesystem::file_time_type> written = std::nullopt) const;
+    std::optional<nlohmann::json> load_from_bundle(std::string_view ns, const std::string& key,
+                                                   std::optional<std::chrono::minutes> ttl,
+                                                   CacheRead mode, bool& was_expired, bool& was_corrupt,
+                                                   std::uint64_t& bytes_read) const;
+    bool preload(std::string_view ns, const std::string& key) const;
 
-    std::optional<nlohmann::json> read_json(const std::filesystem::path& path,
-                                            std::optional<std::chrono::minutes> ttl = std::nullopt) const;
-    void write_json(const std::filesystem::path& path, const nlohmann::json& data) const;
+    // Caller must hold memory_mutex_.
+    const MemoryEntry* recall(const std::string& mem_key) const;
+    void remember(const std::string& mem_key, MemoryEntry entry) const;
+    void forget(const std::string& mem_key) const;
 };
 
 } // namespace valorant
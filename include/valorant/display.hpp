@@ -1,36 +1,31 @@
 #pragma once
 
+#include "valorant/analytics.hpp"
 #include "valorant/api_client.hpp"
 #include "valorant/cache.hpp"
 #include "valorant/rate_limiter.hpp"
 #include "valorant/types.hpp"
+#include <ostream>
 #include <string>
-#include <vector>
 
 namespace valorant {
 
-struct ReportData {
-    PlayerIdentity player;
-    int match_count = 0;
-    OverviewStats overview;
-    std::vector<HourlyPerformance> hourly;
-    std::vector<SessionPerformance> sessions;
-    std::vector<SessionPerformance> rr_sessions;
-    std::vector<RollingMetric> rolling_kda;
-    std::vector<RollingMetric> rolling_wr;
-    DecayCurveModel decay;
-    std::vector<AgentPerformance> agents;
-    std::vector<MapPerformance> maps;
-};
-
 struct AppConfig {
     ClientConfig client;
     std::string region = "na";
     int match_count = 200;
     int window = 20;
     int gap_minutes = 45;
+    int min_session_length = 3; // shortest session counted in the decay fit
+    int warm_players = 0; // preload this many recently viewed players at startup
+    bool dump_cache_stats = false;
+    std::string bundle_path; // read-only cache tier, see Cache::attach_bundle
+    DecayWeighting decay_weighting = DecayWeighting::PositionMeans;
+    int bootstrap_replicates = 2000; // 0 disables the decay slope bootstrap
 };
 
 void run_app(const AppConfig& config);
 
+void print_cache_stats(std::ostream& out, const CacheStats& stats);
+
 } // namespace valorant
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace valorant {
+
+using NameId = std::uint16_t;
+
+// Maps short strings (map, mode and agent names) to small dense ids so
+// per-match records stay compact and analytics can group into plain arrays.
+// Id 0 is always the empty string, and is also returned for new names once
+// every NameId is taken. Safe to use from multiple threads.
+class InternTable {
+public:
+    InternTable();
+
+    NameId intern(std::string_view name);
+    const std::string& name(NameId id) const;
+
+    // Number of ids handed out so far; every id is below this.
+    std::size_t size() const;
+
+private:
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_; // deque keeps references stable on growth
+    std::unordered_map<std::string, NameId, Hash, std::equal_to<>> ids_;
+};
+
+InternTable& map_names();
+InternTable& mode_names();
+InternTable& agent_names();
+
+} // namespace valorant
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace valorant {
+
+struct LocalTime {
+    std::uint8_t hour = 0;    // 0-23
+    std::uint8_t weekday = 0; // 0 = Sunday, as in tm_wday
+};
+
+// Converts unix seconds to the local hour and weekday without the global
+// lock std::localtime takes. The UTC offset is resolved with localtime_r once
+// per UTC day and reused; a day whose start and end offsets differ contains a
+// DST transition and is resolved per call instead. Not thread-safe; give each
+// thread (or each load) its own instance.
+class LocalTimeCache {
+public:
+    LocalTime at(std::int64_t unix_secs);
+
+private:
+    static constexpr std::int32_t transition_day = INT32_MIN;
+
+    std::unordered_map<std::int64_t, std::int32_t> day_offsets_; // UTC day -> offset secs
+};
+
+} // namespace valorant
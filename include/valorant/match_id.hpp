@@ -0,0 +1,116 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace valorant {
+
+// A match id held as 16 bytes instead of its 36-character UUID text. Ids
+// that are not UUIDs are hashed into the same space, so they still compare
+// and hash consistently but to_string() returns the hash, not the input.
+// The all-zero id is "no id" and is what an empty string parses to.
+struct MatchId {
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+
+    static MatchId parse(std::string_view text);
+
+    // Lower-case canonical UUID form; empty for the zero id.
+    std::string to_string() const;
+
+    bool empty() const { return hi == 0 && lo == 0; }
+
+    std::size_t hash() const {
+        // UUID bits are already random; fold and mix so hashed ids spread too
+        std::uint64_t h = (hi ^ (lo * 0x9e3779b97f4a7c15ull)) * 0xff51afd7ed558ccdull;
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+    friend bool operator==(const MatchId&, const MatchId&) = default;
+    friend auto operator<=>(const MatchId&, const MatchId&) = default;
+};
+
+// Flat open-addressing map keyed by MatchId with linear probing. Keys and
+// values live in one contiguous array, so a lookup is a hash and a few
+// 16-byte compares with no allocation. The zero id marks empty slots and
+// cannot be inserted.
+template <typename V>
+class MatchIdMap {
+public:
+    MatchIdMap() = default;
+    explicit MatchIdMap(std::size_t expected) { reserve(expected); }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Saturates at the largest power of two, which rehash() then fails to
+    // allocate, rather than overflowing.
+    void reserve(std::size_t expected) {
+        constexpr std::size_t largest = std::size_t{1} << (std::numeric_limits<std::size_t>::digits - 1);
+        std::size_t want = 16;
+        while (want / 2 < expected && want < largest) want *= 2; // keep load factor <= 0.5
+        if (want > slots_.size()) rehash(want);
+    }
+
+    // Returns the value slot and whether it was newly inserted.
+    std::pair<V*, bool> try_emplace(const MatchId& key, V value = V{}) {
+        if (key.empty()) return {nullptr, false};
+        if ((size_ + 1) * 2 > slots_.size()) rehash(slots_.empty() ? 16 : slots_.size() * 2);
+
+        std::size_t i = slot_for(key);
+        if (slots_[i].key == key) return {&slots_[i].value, false};
+        slots_[i] = {key, std::move(value)};
+        ++size_;
+        return {&slots_[i].value, true};
+    }
+
+    void insert_or_assign(const MatchId& key, V value) {
+        auto [slot, inserted] = try_emplace(key);
+        if (slot) *slot = std::move(value);
+    }
+
+    const V* find(const MatchId& key) const {
+        if (key.empty() || slots_.empty()) return nullptr;
+        auto& slot = slots_[slot_for(key)];
+        return slot.key == key ? &slot.value : nullptr;
+    }
+
+    V* find(const MatchId& key) {
+        return const_cast<V*>(std::as_const(*this).find(key));
+    }
+
+    bool contains(const MatchId& key) const { return find(key) != nullptr; }
+
+private:
+    struct Slot {
+        MatchId key;
+        V value{};
+    };
+
+    // Slot holding `key`, or the empty slot where it belongs.
+    std::size_t slot_for(const MatchId& key) const {
+        std::size_t mask = slots_.size() - 1;
+        std::size_t i = key.hash() & mask;
+        while (!slots_[i].key.empty() && slots_[i].key != key) i = (i + 1) & mask;
+        return i;
+    }
+
+    void rehash(std::size_t capacity) {
+        std::vector<Slot> old(capacity);
+        old.swap(slots_);
+        for (auto& slot : old) {
+            if (!slot.key.empty()) slots_[slot_for(slot.key)] = std::move(slot);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::size_t size_ = 0;
+};
+
+} // namespace valorant
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace valorant {
+
+// Column kernels behind MatchTable's derived KDA and damage-per-round columns.
+// They use AVX2 or NEON when available (chosen at runtime on x86) and a
+// scalar loop otherwise. Zero denominators are handled with max/mask rather
+// than a branch, and every path produces bit-identical results.
+
+// out[i] = (kills[i] + assists[i]) / max(deaths[i], 1)
+void kda_column(const std::int32_t* kills, const std::int32_t* deaths,
+                const std::int32_t* assists, double* out, std::size_t n);
+
+// out[i] = rounds[i] == 0 ? 0 : damage[i] / rounds[i]
+void dpr_column(const std::int32_t* damage, const std::int32_t* rounds,
+                double* out, std::size_t n);
+
+} // namespace valorant
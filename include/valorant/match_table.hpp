@@ -0,0 +1,63 @@
+#pragma once
+
+#include "valorant/local_time.hpp"
+#include "valorant/types.hpp"
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace valorant {
+
+// Column-oriented match history: one contiguous array per field, so a pass
+// over kills/deaths reads only those columns instead of whole summaries.
+// Row i in every column describes the same match. Columns allocate from the
+// memory resource given at construction (see Arena).
+struct MatchTable {
+    std::pmr::vector<MatchId> match_id;
+    std::pmr::vector<std::int64_t> start;  // unix seconds
+    std::pmr::vector<std::uint8_t> local_hour;    // of start, in the local timezone
+    std::pmr::vector<std::uint8_t> local_weekday; // 0 = Sunday
+    std::pmr::vector<std::int32_t> game_length_secs;
+    std::pmr::vector<std::int32_t> kills;
+    std::pmr::vector<std::int32_t> deaths;
+    std::pmr::vector<std::int32_t> assists;
+    std::pmr::vector<std::int32_t> score;
+    std::pmr::vector<std::int32_t> damage;
+    std::pmr::vector<std::int32_t> rounds;
+    std::pmr::vector<std::int32_t> rr_change;
+    std::pmr::vector<std::uint64_t> won_bits;          // bit i set if match i was won
+    std::pmr::vector<std::uint64_t> rr_available_bits; // bit i set if rr_change is known
+    std::pmr::vector<NameId> map_id;
+    std::pmr::vector<NameId> mode_id;
+    std::pmr::vector<NameId> agent_id;
+    // Derived from the columns above by the kernels in match_kernels.hpp
+    std::pmr::vector<double> kda_values;
+    std::pmr::vector<double> dpr_values;
+
+    MatchTable() = default;
+    explicit MatchTable(std::pmr::memory_resource* mr);
+
+    static MatchTable from_matches(
+        const std::vector<PlayerMatchSummary>& matches,
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource());
+
+    std::pmr::memory_resource* resource() const { return kills.get_allocator().resource(); }
+
+    std::size_t size() const { return kills.size(); }
+    bool empty() const { return kills.empty(); }
+
+    void reserve(std::size_t n);
+    void push_back(const PlayerMatchSummary& m);
+    void push_back(const PlayerMatchSummary& m, LocalTimeCache& local_time);
+    PlayerMatchSummary row(std::size_t i) const;
+
+    bool won(std::size_t i) const { return (won_bits[i >> 6] >> (i & 63)) & 1; }
+    bool rr_available(std::size_t i) const { return (rr_available_bits[i >> 6] >> (i & 63)) & 1; }
+
+    double kda(std::size_t i) const { return kda_values[i]; }
+    double damage_per_round(std::size_t i) const { return dpr_values[i]; }
+
+    std::int64_t end(std::size_t i) const { return start[i] + game_length_secs[i]; }
+};
+
+} // namespace valorant
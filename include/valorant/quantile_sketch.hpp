@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace valorant {
+
+// Merging t-digest: approximate quantiles in bounded memory (on the order of
+// `compression` centroids), most accurate in the tails. Sketches built
+// separately - per thread, per player - merge into one. Queries never modify
+// the sketch, so the result of a sequence of adds and merges does not depend
+// on when it was queried.
+class QuantileSketch {
+public:
+    QuantileSketch() = default;
+    explicit QuantileSketch(double compression);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    // q in [0, 1]; 0 for an empty sketch. Exact while every centroid still
+    // holds a single value.
+    double quantile(double q) const;
+
+    double count() const { return total_ + buffered_; }
+    bool empty() const { return count() == 0; }
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void flush();
+    std::vector<Centroid> compressed(std::vector<Centroid> points) const;
+
+    double compression_ = 100.0;
+    std::vector<Centroid> centroids_; // sorted by mean
+    std::vector<Centroid> buffer_;    // unsorted, folded in by flush()
+    double total_ = 0.0;    // weight held in centroids_
+    double buffered_ = 0.0; // weight held in buffer_
+    double min_ = 0.0;
+    double max_ = 0.0;
+};
+
+} // namespace valorant
@@ -1,11 +1,18 @@
 #pragma once
 
+#include "valorant/match_table.hpp"
 #include "valorant/types.hpp"
 #include <chrono>
 #include <vector>
 
 namespace valorant {
 
+// Sessions are index ranges into the storage they were detected from, so
+// re-sessionizing with a different gap allocates only the range list.
+std::vector<Session> detect_sessions(
+    const MatchTable& table,
+    std::chrono::minutes gap_threshold = std::chrono::minutes(45));
+
 std::vector<Session> detect_sessions(
     const std::vector<PlayerMatchSummary>& matches,
     std::chrono::minutes gap_threshold = std::chrono::minutes(45));
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "valorant/intern.hpp"
+#include "valorant/match_id.hpp"
+#include <array>
 #include <chrono>
 #include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -19,10 +23,10 @@ struct PlayerIdentity {
 };
 
 struct PlayerMatchSummary {
-    std::string match_id;
-    std::string map;
-    std::string mode;
-    std::string agent;
+    MatchId match_id;
+    NameId map_id = 0;   // see map_names()
+    NameId mode_id = 0;  // see mode_names()
+    NameId agent_id = 0; // see agent_names()
     TimePoint game_start;
     int game_length_secs = 0;
     int kills = 0;
@@ -44,22 +48,23 @@ struct PlayerMatchSummary {
         return rounds_played == 0 ? 0.0
                                   : static_cast<double>(damage_made) / rounds_played;
     }
+
+    const std::string& map() const { return map_names().name(map_id); }
+    const std::string& mode() const { return mode_names().name(mode_id); }
+    const std::string& agent() const { return agent_names().name(agent_id); }
 };
 
+// Rows [begin, end) of the match storage the session was detected from.
 struct Session {
     int index = 0;
-    std::vector<PlayerMatchSummary> matches;
+    int begin = 0;
+    int end = 0;
 
-    TimePoint start() const { return matches.front().game_start; }
-    TimePoint end() const {
-        auto& last = matches.back();
-        return last.game_start + std::chrono::seconds(last.game_length_secs);
-    }
-    int game_count() const { return static_cast<int>(matches.size()); }
+    int game_count() const { return end - begin; }
 };
 
 struct MmrHistoryEntry {
-    std::string match_id;
+    MatchId match_id;
     int rr_change = 0;
     int rr_after = 0;
     int tier_after = 0;
@@ -68,11 +73,35 @@ struct MmrHistoryEntry {
 
 // Analytics output types
 
+// Spread of a per-game metric, from a QuantileSketch
+struct Quantiles {
+    double p10 = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+};
+
 struct HourlyPerformance {
     int hour = 0;
     double avg_kda = 0.0;
     double win_rate = 0.0;
     int match_count = 0;
+    Quantiles kda_quantiles;
+};
+
+struct HeatmapCell {
+    int match_count = 0;
+    double avg_kda = 0.0;
+    double win_rate = 0.0;
+    double avg_rr = 0.0;
+};
+
+// Dense local weekday x hour grid; weekday 0 = Sunday, as in tm_wday
+struct WeekHourHeatmap {
+    static constexpr int days = 7;
+    static constexpr int hours = 24;
+    std::array<HeatmapCell, days * hours> cells{};
+
+    const HeatmapCell& at(int weekday, int hour) const { return cells[weekday * hours + hour]; }
 };
 
 struct SessionGameMetric {
@@ -88,20 +117,71 @@ struct SessionPerformance {
     int total_rr = 0;
     double avg_rr_per_game = 0.0;
     double avg_kda = 0.0;
-    std::vector<SessionGameMetric> games;
+    std::pmr::vector<SessionGameMetric> games;
+};
+
+// values[i] is the metric over the window ending at match first_index + i.
+// Match ids are not copied; look them up in the source table when needed.
+struct RollingSeries {
+    int first_index = 0;
+    std::pmr::vector<double> values;
+
+    std::size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    double operator[](std::size_t i) const { return values[i]; }
+    int match_index(std::size_t i) const { return first_index + static_cast<int>(i); }
+
+    auto begin() const { return values.begin(); }
+    auto end() const { return values.end(); }
+};
+
+enum class RollingStat : std::uint8_t { Kda, WinRate, DamagePerRound, RrChange };
+
+// Every requested (stat, window) combination from one rolling_metrics() call.
+struct RollingSet {
+    std::vector<RollingStat> stats;
+    std::vector<int> windows;
+    std::vector<RollingSeries> series; // series[s * windows.size() + w]
+
+    const RollingSeries* find(RollingStat stat, int window) const {
+        for (std::size_t s = 0; s < stats.size(); ++s) {
+            if (stats[s] != stat) continue;
+            for (std::size_t w = 0; w < windows.size(); ++w) {
+                if (windows[w] == window) return &series[s * windows.size() + w];
+            }
+        }
+        return nullptr;
+    }
 };
 
-struct RollingMetric {
-    int match_index = 0;
-    std::string match_id;
-    double value = 0.0;
+enum class DecayWeighting : std::uint8_t { PositionMeans, Samples };
+
+// Bootstrap uncertainty for a decay slope; replicates == 0 when not computed.
+struct DecayBootstrap {
+    int replicates = 0; // replicates that produced a fit
+    double confidence = 0.0;
+    double ci_low = 0.0;
+    double ci_high = 0.0;
+    double p_value = 1.0; // two-sided, against a slope of zero; at least 2 / (replicates + 1)
 };
 
 struct DecayCurveModel {
     double slope = 0.0;
     double intercept = 0.0;
     double r_squared = 0.0;
+    double slope_std_error = 0.0; // 0 when fewer than three points (or games)
     std::vector<std::pair<int, double>> points; // (game_number, avg_kda)
+    std::vector<std::int64_t> sample_counts;    // games behind each point
+    std::vector<Quantiles> point_quantiles;     // KDA spread per point; empty unless tracked
+    DecayBootstrap bootstrap;
+};
+
+struct GapSweepPoint {
+    int gap_minutes = 0;
+    int session_count = 0;
+    double avg_session_length = 0.0; // games
+    int qualifying_sessions = 0;     // sessions long enough for the decay fit
+    double decay_slope = 0.0;        // per-game (DecayWeighting::Samples) fit
 };
 
 struct AgentPerformance {
@@ -111,6 +191,8 @@ struct AgentPerformance {
     double win_rate = 0.0;
     double avg_damage_per_round = 0.0;
     double pick_rate = 0.0;
+    Quantiles kda_quantiles;
+    Quantiles dpr_quantiles;
 };
 
 struct MapPerformance {
@@ -119,6 +201,27 @@ struct MapPerformance {
     double avg_kda = 0.0;
     double win_rate = 0.0;
     double avg_score = 0.0;
+    Quantiles kda_quantiles;
+};
+
+struct AgentMapCell {
+    int games = 0;
+    double avg_kda = 0.0;
+    double win_rate = 0.0;
+    double avg_damage_per_round = 0.0;
+};
+
+// Agent x map table over the agents and maps actually played. Rows follow
+// agent_totals and columns map_totals (most played first); the totals are the
+// marginals and equal performance_by_agent / performance_by_map exactly.
+struct AgentMapCrossTab {
+    std::vector<AgentPerformance> agent_totals;
+    std::vector<MapPerformance> map_totals;
+    std::vector<AgentMapCell> cells; // row-major, agent_totals.size() x map_totals.size()
+
+    const AgentMapCell& at(std::size_t agent, std::size_t map) const {
+        return cells[agent * map_totals.size() + map];
+    }
 };
 
 struct OverviewStats {
@@ -142,6 +245,18 @@ struct OverviewStats {
     double headshot_pct = 0.0;
 };
 
+// Everything aggregate_matches() derives from one pass over a match table.
+struct MatchAggregates {
+    OverviewStats overview;
+    std::vector<HourlyPerformance> hourly;
+    WeekHourHeatmap heatmap;
+    std::vector<AgentPerformance> agents;
+    std::vector<MapPerformance> maps;
+    AgentMapCrossTab crosstab; // totals are copies of agents and maps
+    RollingSeries rolling_kda;
+    RollingSeries rolling_wr;
+};
+
 struct ApiError {
     int status_code = 0;
     std::string message;
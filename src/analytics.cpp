@@ -1,32 +1,64 @@
 #include "valorant/analytics.hpp"
 #include <algorithm>
+#include <array>
 #include <cmath>
-#include <numeric>
-#include <unordered_map>
 
 namespace valorant {
 
-std::vector<HourlyPerformance> performance_by_hour(
-    const std::vector<PlayerMatchSummary>& matches) {
+namespace {
 
-    struct Bucket {
-        double total_kda = 0.0;
-        int wins = 0;
-        int count = 0;
-    };
+// Per-group running totals shared by the standalone analyses and the fused
+// report pass, so both produce identical numbers.
+struct GroupAcc {
+    double total_kda = 0.0;
+    double total_extra = 0.0; // damage per round for agents, score for maps
+    int wins = 0;
+    int count = 0;
+    QuantileSketch kda_sketch;
+
+    void add(double kda, double extra, bool won) {
+        total_kda += kda;
+        total_extra += extra;
+        wins += won ? 1 : 0;
+        count++;
+        kda_sketch.add(kda);
+    }
 
-    std::array<Bucket, 24> buckets{};
+    void merge(const GroupAcc& other) {
+        total_kda += other.total_kda;
+        total_extra += other.total_extra;
+        wins += other.wins;
+        count += other.count;
+        kda_sketch.merge(other.kda_sketch);
+    }
+};
 
-    for (auto& m : matches) {
-        auto tt = std::chrono::system_clock::to_time_t(m.game_start);
-        auto* lt = std::localtime(&tt);
-        int hour = lt->tm_hour;
+// Agents are the only group whose damage per round spread is shown
+struct AgentAcc : GroupAcc {
+    QuantileSketch dpr_sketch;
 
-        buckets[hour].total_kda += m.kda();
-        buckets[hour].wins += m.won ? 1 : 0;
-        buckets[hour].count++;
+    void add(double kda, double dpr, bool won) {
+        GroupAcc::add(kda, dpr, won);
+        dpr_sketch.add(dpr);
     }
 
+    void merge(const AgentAcc& other) {
+        GroupAcc::merge(other);
+        dpr_sketch.merge(other.dpr_sketch);
+    }
+};
+
+Quantiles spread(const QuantileSketch& sketch) {
+    return {
+        .p10 = sketch.quantile(0.10),
+        .p50 = sketch.quantile(0.50),
+        .p90 = sketch.quantile(0.90),
+    };
+}
+
+using HourBuckets = std::array<GroupAcc, 24>;
+
+std::vector<HourlyPerformance> finish_hourly(const HourBuckets& buckets) {
     std::vector<HourlyPerformance> result;
     for (int h = 0; h < 24; ++h) {
         if (buckets[h].count == 0) continue;
@@ -35,34 +67,286 @@ std::vector<HourlyPerformance> performance_by_hour(
             .avg_kda = buckets[h].total_kda / buckets[h].count,
             .win_rate = static_cast<double>(buckets[h].wins) / buckets[h].count,
             .match_count = buckets[h].count,
+            .kda_quantiles = spread(buckets[h].kda_sketch),
         });
     }
+    return result;
+}
+
+// Heatmap cells stay plain sums (no sketches) so 168 of them remain cheap
+struct CellAcc {
+    double total_kda = 0.0;
+    std::int64_t total_rr = 0;
+    int wins = 0;
+    int count = 0;
+
+    void add(double kda, int rr, bool won) {
+        total_kda += kda;
+        total_rr += rr;
+        wins += won ? 1 : 0;
+        count++;
+    }
+
+    void merge(const CellAcc& other) {
+        total_kda += other.total_kda;
+        total_rr += other.total_rr;
+        wins += other.wins;
+        count += other.count;
+    }
+};
 
+using HeatmapBuckets = std::array<CellAcc, WeekHourHeatmap::days * WeekHourHeatmap::hours>;
+
+void add_heatmap(HeatmapBuckets& cells, const MatchTable& table, size_t i, double kda, bool won) {
+    cells[table.local_weekday[i] * WeekHourHeatmap::hours + table.local_hour[i]].add(
+        kda, table.rr_change[i], won);
+}
+
+WeekHourHeatmap finish_heatmap(const HeatmapBuckets& cells) {
+    WeekHourHeatmap result;
+    for (size_t c = 0; c < cells.size(); ++c) {
+        auto& acc = cells[c];
+        if (acc.count == 0) continue;
+        result.cells[c] = {
+            .match_count = acc.count,
+            .avg_kda = acc.total_kda / acc.count,
+            .win_rate = static_cast<double>(acc.wins) / acc.count,
+            .avg_rr = static_cast<double>(acc.total_rr) / acc.count,
+        };
+    }
+    return result;
+}
+
+// Ids of the groups that were played, most games first. Agent and map tables
+// list rows in this order, and the cross-tab takes its rows and columns from it.
+template <typename Acc>
+std::vector<NameId> played_order(const std::vector<Acc>& groups) {
+    std::vector<NameId> ids;
+    for (size_t id = 0; id < groups.size(); ++id) {
+        if (groups[id].count > 0) ids.push_back(static_cast<NameId>(id));
+    }
+    std::ranges::stable_sort(ids, std::greater{}, [&](NameId id) { return groups[id].count; });
+    return ids;
+}
+
+std::vector<AgentPerformance> finish_agents(const std::vector<AgentAcc>& by_agent,
+                                            std::span<const NameId> order, int total) {
+    std::vector<AgentPerformance> result;
+    result.reserve(order.size());
+    for (auto id : order) {
+        auto& acc = by_agent[id];
+        result.push_back({
+            .agent = agent_names().name(id),
+            .games = acc.count,
+            .avg_kda = acc.total_kda / acc.count,
+            .win_rate = static_cast<double>(acc.wins) / acc.count,
+            .avg_damage_per_round = acc.total_extra / acc.count,
+            .pick_rate = total > 0 ? static_cast<double>(acc.count) / total : 0.0,
+            .kda_quantiles = spread(acc.kda_sketch),
+            .dpr_quantiles = spread(acc.dpr_sketch),
+        });
+    }
     return result;
 }
 
+std::vector<AgentPerformance> finish_agents(const std::vector<AgentAcc>& by_agent, int total) {
+    return finish_agents(by_agent, played_order(by_agent), total);
+}
+
+std::vector<MapPerformance> finish_maps(const std::vector<GroupAcc>& by_map,
+                                        std::span<const NameId> order) {
+    std::vector<MapPerformance> result;
+    result.reserve(order.size());
+    for (auto id : order) {
+        auto& acc = by_map[id];
+        result.push_back({
+            .map = map_names().name(id),
+            .games = acc.count,
+            .avg_kda = acc.total_kda / acc.count,
+            .win_rate = static_cast<double>(acc.wins) / acc.count,
+            .avg_score = acc.total_extra / acc.count,
+            .kda_quantiles = spread(acc.kda_sketch),
+        });
+    }
+    return result;
+}
+
+std::vector<MapPerformance> finish_maps(const std::vector<GroupAcc>& by_map) {
+    return finish_maps(by_map, played_order(by_map));
+}
+
+// Agent x map cells are plain sums like the heatmap's
+struct GridCellAcc {
+    double total_kda = 0.0;
+    double total_dpr = 0.0;
+    int wins = 0;
+    int count = 0;
+
+    void add(double kda, double dpr, bool won) {
+        total_kda += kda;
+        total_dpr += dpr;
+        wins += won ? 1 : 0;
+        count++;
+    }
+
+    void merge(const GridCellAcc& other) {
+        total_kda += other.total_kda;
+        total_dpr += other.total_dpr;
+        wins += other.wins;
+        count += other.count;
+    }
+};
+
+struct OverviewAcc {
+    OverviewStats stats;
+    double total_dpr = 0.0;
+    int leading = 0; // streak the range opens with; positive = wins, negative = losses
+    int streak = 0;  // streak the range ends with
+    int max_win = 0;
+    int max_loss = 0;
+
+    void add(const MatchTable& table, size_t i, double dpr, bool won) {
+        stats.total_games++;
+        stats.total_kills += table.kills[i];
+        stats.total_deaths += table.deaths[i];
+        stats.total_assists += table.assists[i];
+        stats.total_rr += table.rr_change[i];
+        total_dpr += dpr;
+
+        if (won) {
+            stats.wins++;
+            streak = streak > 0 ? streak + 1 : 1;
+            max_win = std::max(max_win, streak);
+        } else {
+            stats.losses++;
+            streak = streak < 0 ? streak - 1 : -1;
+            max_loss = std::max(max_loss, -streak);
+        }
+        if (std::abs(streak) == stats.total_games) leading = streak;
+    }
+
+    // Appends the accumulator for the rows immediately after this one.
+    void merge(const OverviewAcc& next) {
+        if (next.stats.total_games == 0) return;
+        if (stats.total_games == 0) {
+            *this = next;
+            return;
+        }
+
+        bool uniform = std::abs(leading) == stats.total_games;
+        bool next_uniform = std::abs(next.leading) == next.stats.total_games;
+        bool joined = (streak > 0) == (next.leading > 0);
+
+        max_win = std::max(max_win, next.max_win);
+        max_loss = std::max(max_loss, next.max_loss);
+        if (joined) {
+            int run = streak + next.leading;
+            if (run > 0) max_win = std::max(max_win, run);
+            else max_loss = std::max(max_loss, -run);
+            if (uniform) leading = run;
+            streak = next_uniform ? run : next.streak;
+        } else {
+            streak = next.streak;
+        }
+
+        stats.total_games += next.stats.total_games;
+        stats.wins += next.stats.wins;
+        stats.losses += next.stats.losses;
+        stats.total_kills += next.stats.total_kills;
+        stats.total_deaths += next.stats.total_deaths;
+        stats.total_assists += next.stats.total_assists;
+        stats.total_rr += next.stats.total_rr;
+        total_dpr += next.total_dpr;
+    }
+
+    OverviewStats finish(const std::vector<AgentPerformance>& agents,
+                         const std::vector<MapPerformance>& maps) const {
+        OverviewStats result = stats;
+
+        if (result.total_deaths > 0) {
+            result.overall_kda = static_cast<double>(result.total_kills + result.total_assists)
+                                 / result.total_deaths;
+        } else {
+            result.overall_kda = static_cast<double>(result.total_kills + result.total_assists);
+        }
+
+        if (result.total_games > 0) {
+            result.win_rate = static_cast<double>(result.wins) / result.total_games;
+            result.avg_damage_per_round = total_dpr / result.total_games;
+        }
+
+        // Best agent by KDA (min 3 games)
+        for (auto& a : agents) {
+            if (a.games >= 3 && a.avg_kda > result.best_agent_kda) {
+                result.best_agent = a.agent;
+                result.best_agent_kda = a.avg_kda;
+            }
+        }
+
+        // Worst map by WR (min 3 games)
+        for (auto& m : maps) {
+            if (m.games >= 3 && m.win_rate < result.worst_map_wr) {
+                result.worst_map = m.map;
+                result.worst_map_wr = m.win_rate;
+            }
+        }
+
+        result.longest_win_streak = max_win;
+        result.longest_loss_streak = max_loss;
+        result.current_streak = streak;
+        return result;
+    }
+};
+
+} // namespace
+
+std::vector<HourlyPerformance> performance_by_hour(const MatchTable& table) {
+    HourBuckets buckets{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        buckets[table.local_hour[i]].add(table.kda(i), 0.0, table.won(i));
+    }
+    return finish_hourly(buckets);
+}
+
+std::vector<HourlyPerformance> performance_by_hour(
+    const std::vector<PlayerMatchSummary>& matches) {
+    return performance_by_hour(MatchTable::from_matches(matches));
+}
+
+WeekHourHeatmap performance_by_weekday_hour(const MatchTable& table) {
+    HeatmapBuckets cells{};
+    for (size_t i = 0; i < table.size(); ++i) add_heatmap(cells, table, i, table.kda(i), table.won(i));
+    return finish_heatmap(cells);
+}
+
+WeekHourHeatmap performance_by_weekday_hour(
+    const std::vector<PlayerMatchSummary>& matches) {
+    return performance_by_weekday_hour(MatchTable::from_matches(matches));
+}
+
 std::vector<SessionPerformance> performance_by_session(
-    const std::vector<Session>& sessions) {
+    const MatchTable& table, const std::vector<Session>& sessions) {
 
     std::vector<SessionPerformance> result;
     for (auto& session : sessions) {
-        SessionPerformance sp;
+        SessionPerformance sp{.games = std::pmr::vector<SessionGameMetric>(table.resource())};
         sp.session_index = session.index;
         sp.game_count = session.game_count();
+        sp.games.reserve(sp.game_count);
 
         double total_kda = 0.0;
         int total_rr = 0;
 
-        for (int i = 0; i < static_cast<int>(session.matches.size()); ++i) {
-            auto& m = session.matches[i];
-            total_kda += m.kda();
-            total_rr += m.rr_change;
+        for (int i = session.begin; i < session.end; ++i) {
+            double kda = table.kda(i);
+            total_kda += kda;
+            total_rr += table.rr_change[i];
 
             sp.games.push_back({
-                .game_number = i + 1,
-                .kda = m.kda(),
-                .damage_per_round = m.damage_per_round(),
-                .rr_change = m.rr_change,
+                .game_number = i - session.begin + 1,
+                .kda = kda,
+                .damage_per_round = table.damage_per_round(i),
+                .rr_change = table.rr_change[i],
             });
         }
 
@@ -78,78 +362,173 @@ std::vector<SessionPerformance> performance_by_session(
     return result;
 }
 
+std::vector<SessionPerformance> performance_by_session(
+    const std::vector<PlayerMatchSummary>& matches, const std::vector<Session>& sessions) {
+    return performance_by_session(MatchTable::from_matches(matches), sessions);
+}
+
 std::vector<SessionPerformance> rr_by_session(
-    const std::vector<Session>& sessions) {
-    return performance_by_session(sessions);
+    const MatchTable& table, const std::vector<Session>& sessions) {
+    return performance_by_session(table, sessions);
 }
 
-std::vector<RollingMetric> rolling_kda(
-    const std::vector<PlayerMatchSummary>& matches, int window) {
+std::vector<SessionPerformance> rr_by_session(
+    const std::vector<PlayerMatchSummary>& matches, const std::vector<Session>& sessions) {
+    return performance_by_session(matches, sessions);
+}
 
-    std::vector<RollingMetric> result;
-    int n = static_cast<int>(matches.size());
-    int effective_window = std::min(window, n);
+namespace {
 
-    for (int i = effective_window - 1; i < n; ++i) {
-        double sum = 0.0;
-        for (int j = i - effective_window + 1; j <= i; ++j) {
-            sum += matches[j].kda();
-        }
-        result.push_back({
-            .match_index = i,
-            .match_id = matches[i].match_id,
-            .value = sum / effective_window,
-        });
+double rolling_value(const MatchTable& table, RollingStat stat, std::size_t i) {
+    switch (stat) {
+        case RollingStat::Kda: return table.kda(i);
+        case RollingStat::WinRate: return table.won(i) ? 1.0 : 0.0;
+        case RollingStat::DamagePerRound: return table.damage_per_round(i);
+        case RollingStat::RrChange: return table.rr_change[i];
     }
-
-    return result;
+    return 0.0;
 }
 
-std::vector<RollingMetric> rolling_win_rate(
-    const std::vector<PlayerMatchSummary>& matches, int window) {
+} // namespace
+
+RollingSet rolling_metrics(const MatchTable& table,
+                           std::span<const RollingStat> stats,
+                           std::span<const int> windows) {
+    RollingSet set{
+        .stats = {stats.begin(), stats.end()},
+        .windows = {windows.begin(), windows.end()},
+        .series = {},
+    };
 
-    std::vector<RollingMetric> result;
-    int n = static_cast<int>(matches.size());
-    int effective_window = std::min(window, n);
+    int n = static_cast<int>(table.size());
+    std::vector<int> effective(windows.size());
+    for (std::size_t w = 0; w < windows.size(); ++w) {
+        effective[w] = std::min(windows[w], n);
+    }
 
-    for (int i = effective_window - 1; i < n; ++i) {
-        int wins = 0;
-        for (int j = i - effective_window + 1; j <= i; ++j) {
-            wins += matches[j].won ? 1 : 0;
+    for (std::size_t s = 0; s < stats.size(); ++s) {
+        for (int eff : effective) {
+            RollingSeries series{.values = std::pmr::vector<double>(table.resource())};
+            if (eff > 0) {
+                series.first_index = eff - 1;
+                series.values.reserve(n - eff + 1);
+            }
+            set.series.push_back(std::move(series));
         }
-        result.push_back({
-            .match_index = i,
-            .match_id = matches[i].match_id,
-            .value = static_cast<double>(wins) / effective_window,
-        });
     }
 
-    return result;
+    // One running sum per (stat, window): add the row entering the window,
+    // drop the row leaving it.
+    std::vector<double> sums(set.series.size(), 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (std::size_t s = 0; s < stats.size(); ++s) {
+            double entering = rolling_value(table, stats[s], i);
+            for (std::size_t w = 0; w < windows.size(); ++w) {
+                int eff = effective[w];
+                if (eff <= 0) continue;
+                auto k = s * windows.size() + w;
+                sums[k] += entering;
+                if (i >= eff) sums[k] -= rolling_value(table, stats[s], i - eff);
+                if (i >= eff - 1) set.series[k].values.push_back(sums[k] / eff);
+            }
+        }
+    }
+
+    return set;
 }
 
-DecayCurveModel decay_curve(
-    const std::vector<Session>& sessions, int min_session_length) {
+RollingSeries rolling_kda(const MatchTable& table, int window) {
+    RollingStat stat = RollingStat::Kda;
+    return std::move(rolling_metrics(table, {&stat, 1}, {&window, 1}).series.front());
+}
 
-    std::unordered_map<int, std::vector<double>> by_position;
+RollingSeries rolling_kda(
+    const std::vector<PlayerMatchSummary>& matches, int window) {
+    return rolling_kda(MatchTable::from_matches(matches), window);
+}
 
-    for (auto& session : sessions) {
-        if (session.game_count() < min_session_length) continue;
-        for (int i = 0; i < static_cast<int>(session.matches.size()); ++i) {
-            by_position[i + 1].push_back(session.matches[i].kda());
-        }
+RollingSeries rolling_win_rate(const MatchTable& table, int window) {
+    RollingStat stat = RollingStat::WinRate;
+    return std::move(rolling_metrics(table, {&stat, 1}, {&window, 1}).series.front());
+}
+
+RollingSeries rolling_win_rate(
+    const std::vector<PlayerMatchSummary>& matches, int window) {
+    return rolling_win_rate(MatchTable::from_matches(matches), window);
+}
+
+DecayAccumulator::DecayAccumulator(bool track_quantiles) : track_quantiles_(track_quantiles) {}
+
+void DecayAccumulator::add(int position, double kda) {
+    if (position < 1) return;
+    if (positions_.size() < static_cast<size_t>(position)) positions_.resize(position);
+    auto& p = positions_[position - 1];
+    p.count++;
+    p.sum += kda;
+    p.sum_sq += kda * kda;
+
+    if (!track_quantiles_) return;
+    if (sketches_.size() < static_cast<size_t>(position)) sketches_.resize(position);
+    sketches_[position - 1].add(kda);
+}
+
+void DecayAccumulator::add_session(const MatchTable& table, const Session& session) {
+    for (int i = session.begin; i < session.end; ++i) add(i - session.begin + 1, table.kda(i));
+}
+
+void DecayAccumulator::merge(const DecayAccumulator& other) {
+    if (positions_.size() < other.positions_.size()) positions_.resize(other.positions_.size());
+    for (size_t i = 0; i < other.positions_.size(); ++i) {
+        positions_[i].count += other.positions_[i].count;
+        positions_[i].sum += other.positions_[i].sum;
+        positions_[i].sum_sq += other.positions_[i].sum_sq;
     }
 
+    if (!track_quantiles_) return;
+    if (sketches_.size() < other.sketches_.size()) sketches_.resize(other.sketches_.size());
+    for (size_t i = 0; i < other.sketches_.size(); ++i) sketches_[i].merge(other.sketches_[i]);
+}
+
+DecayCurveModel DecayAccumulator::fit(DecayWeighting weighting) const {
     DecayCurveModel model;
-    for (auto& [pos, kdas] : by_position) {
-        double avg = std::accumulate(kdas.begin(), kdas.end(), 0.0) / kdas.size();
-        model.points.emplace_back(pos, avg);
+    for (size_t pos = 0; pos < positions_.size(); ++pos) {
+        auto& p = positions_[pos];
+        if (p.count == 0) continue;
+        model.points.emplace_back(static_cast<int>(pos) + 1, p.sum / p.count);
+        model.sample_counts.push_back(p.count);
+        if (track_quantiles_) model.point_quantiles.push_back(spread(sketches_[pos]));
     }
 
-    std::ranges::sort(model.points, {}, &std::pair<int, double>::first);
-
     if (model.points.size() < 2) return model;
 
-    // Least squares linear regression
+    if (weighting == DecayWeighting::Samples) {
+        // Ordinary least squares over every game, from the per-position sums
+        double n = 0, sum_x = 0, sum_y = 0, sum_xy = 0, sum_xx = 0, sum_yy = 0;
+        for (size_t pos = 0; pos < positions_.size(); ++pos) {
+            auto& p = positions_[pos];
+            double x = static_cast<double>(pos + 1);
+            n += p.count;
+            sum_x += p.count * x;
+            sum_xx += p.count * x * x;
+            sum_y += p.sum;
+            sum_xy += x * p.sum;
+            sum_yy += p.sum_sq;
+        }
+
+        double sxx = sum_xx - sum_x * sum_x / n;
+        if (sxx < 1e-10) return model;
+
+        model.slope = (sum_xy - sum_x * sum_y / n) / sxx;
+        model.intercept = (sum_y - model.slope * sum_x) / n;
+
+        double ss_tot = sum_yy - sum_y * sum_y / n;
+        double ss_res = std::max(0.0, sum_yy - model.intercept * sum_y - model.slope * sum_xy);
+        model.r_squared = ss_tot > 1e-10 ? 1.0 - ss_res / ss_tot : 0.0;
+        if (n > 2) model.slope_std_error = std::sqrt(ss_res / (n - 2) / sxx);
+        return model;
+    }
+
+    // Least squares linear regression over the position means
     double n = static_cast<double>(model.points.size());
     double sum_x = 0, sum_y = 0, sum_xy = 0, sum_xx = 0;
     for (auto& [x, y] : model.points) {
@@ -175,146 +554,622 @@ DecayCurveModel decay_curve(
     }
 
     model.r_squared = ss_tot > 1e-10 ? 1.0 - ss_res / ss_tot : 0.0;
+    if (n > 2) model.slope_std_error = std::sqrt(ss_res / (n - 2) / (denom / n));
     return model;
 }
 
-std::vector<AgentPerformance> performance_by_agent(
-    const std::vector<PlayerMatchSummary>& matches) {
+DecayCurveModel decay_curve(
+    const MatchTable& table, const std::vector<Session>& sessions,
+    int min_session_length, DecayWeighting weighting) {
 
-    struct Acc {
-        double total_kda = 0.0;
-        double total_dpr = 0.0;
-        int wins = 0;
-        int count = 0;
-    };
+    DecayAccumulator acc(true);
+    for (auto& session : sessions) {
+        if (session.game_count() < min_session_length) continue;
+        acc.add_session(table, session);
+    }
+    return acc.fit(weighting);
+}
 
-    std::unordered_map<std::string, Acc> by_agent;
-    for (auto& m : matches) {
-        auto& a = by_agent[m.agent];
-        a.total_kda += m.kda();
-        a.total_dpr += m.damage_per_round();
-        a.wins += m.won ? 1 : 0;
-        a.count++;
+DecayCurveModel decay_curve(
+    const std::vector<PlayerMatchSummary>& matches, const std::vector<Session>& sessions,
+    int min_session_length, DecayWeighting weighting) {
+    return decay_curve(MatchTable::from_matches(matches), sessions, min_session_length, weighting);
+}
+
+namespace {
+
+// One session's contribution to the per-game decay regression; j is the
+// 1-based position within the session.
+struct SessionSums {
+    std::int64_t length = 0;
+    double sum_y = 0.0;
+    double sum_jy = 0.0;
+
+    // `next` starts right after this session ends, so its positions shift
+    void join(const SessionSums& next) {
+        sum_jy += next.sum_jy + static_cast<double>(length) * next.sum_y;
+        sum_y += next.sum_y;
+        length += next.length;
     }
+};
+
+// Regression sums over every qualifying session. Position sums are exact
+// integers, so removing a session on a join introduces no drift in them.
+struct SweepFit {
+    std::int64_t n = 0, sum_x = 0, sum_xx = 0;
+    double sum_y = 0.0, sum_xy = 0.0;
+
+    void add(const SessionSums& s, int sign) {
+        auto len = s.length;
+        n += sign * len;
+        sum_x += sign * (len * (len + 1) / 2);
+        sum_xx += sign * (len * (len + 1) * (2 * len + 1) / 6);
+        sum_y += sign * s.sum_y;
+        sum_xy += sign * s.sum_jy;
+    }
+
+    double slope() const {
+        if (n == 0) return 0.0;
+        double sxx = sum_xx - static_cast<double>(sum_x) * sum_x / n;
+        if (sxx < 1e-10) return 0.0;
+        return (sum_xy - sum_x * sum_y / n) / sxx;
+    }
+};
+
+} // namespace
+
+std::vector<GapSweepPoint> sweep_gap_thresholds(
+    const MatchTable& table, std::span<const int> gap_minutes, int min_session_length) {
+
+    std::vector<int> thresholds(gap_minutes.begin(), gap_minutes.end());
+    std::ranges::sort(thresholds);
+
+    int n = static_cast<int>(table.size());
+    std::vector<GapSweepPoint> result;
+    result.reserve(thresholds.size());
+    if (n == 0) {
+        for (int t : thresholds) result.push_back({.gap_minutes = t});
+        return result;
+    }
+
+    // (gap before row i, i); a session splits at row i when the gap exceeds
+    // the threshold, matching detect_sessions
+    std::vector<std::pair<std::int64_t, int>> gaps;
+    gaps.reserve(n - 1);
+    for (int i = 1; i < n; ++i) gaps.emplace_back(table.start[i] - table.end(i - 1), i);
+    std::ranges::sort(gaps);
+
+    // Every row starts as its own session. Sums live at a session's first
+    // row; first_row_of maps a session's last row back to its first.
+    std::vector<SessionSums> sums(n);
+    std::vector<int> first_row_of(n);
+    SweepFit fit;
+    int qualifying = 0;
+    for (int i = 0; i < n; ++i) {
+        double y = table.kda(i);
+        sums[i] = {.length = 1, .sum_y = y, .sum_jy = y};
+        first_row_of[i] = i;
+        if (min_session_length <= 1) {
+            fit.add(sums[i], 1);
+            qualifying++;
+        }
+    }
+
+    int sessions = n;
+    size_t next = 0;
+    for (int t : thresholds) {
+        auto secs = static_cast<std::int64_t>(t) * 60;
+        for (; next < gaps.size() && gaps[next].first <= secs; ++next) {
+            int row = gaps[next].second;
+            int first = first_row_of[row - 1];
+            auto& left = sums[first];
+            auto& right = sums[row];
+            for (auto* part : {&left, &right}) {
+                if (part->length >= min_session_length) {
+                    fit.add(*part, -1);
+                    qualifying--;
+                }
+            }
+            left.join(right);
+            first_row_of[first + left.length - 1] = first;
+            if (left.length >= min_session_length) {
+                fit.add(left, 1);
+                qualifying++;
+            }
+            sessions--;
+        }
 
-    int total = static_cast<int>(matches.size());
-    std::vector<AgentPerformance> result;
-    for (auto& [agent, acc] : by_agent) {
         result.push_back({
-            .agent = agent,
-            .games = acc.count,
-            .avg_kda = acc.total_kda / acc.count,
-            .win_rate = static_cast<double>(acc.wins) / acc.count,
-            .avg_damage_per_round = acc.total_dpr / acc.count,
-            .pick_rate = total > 0 ? static_cast<double>(acc.count) / total : 0.0,
+            .gap_minutes = t,
+            .session_count = sessions,
+            .avg_session_length = static_cast<double>(n) / sessions,
+            .qualifying_sessions = qualifying,
+            .decay_slope = fit.slope(),
         });
     }
-
-    std::ranges::sort(result, std::greater{}, &AgentPerformance::games);
     return result;
 }
 
+std::vector<AgentPerformance> performance_by_agent(const MatchTable& table) {
+    // Ids are dense, so grouping is an array increment rather than a hash lookup
+    std::vector<AgentAcc> by_agent(agent_names().size());
+    for (size_t i = 0; i < table.size(); ++i) {
+        by_agent[table.agent_id[i]].add(table.kda(i), table.damage_per_round(i), table.won(i));
+    }
+    return finish_agents(by_agent, static_cast<int>(table.size()));
+}
+
+std::vector<AgentPerformance> performance_by_agent(
+    const std::vector<PlayerMatchSummary>& matches) {
+    return performance_by_agent(MatchTable::from_matches(matches));
+}
+
+std::vector<MapPerformance> performance_by_map(const MatchTable& table) {
+    std::vector<GroupAcc> by_map(map_names().size());
+    for (size_t i = 0; i < table.size(); ++i) {
+        by_map[table.map_id[i]].add(table.kda(i), table.score[i], table.won(i));
+    }
+    return finish_maps(by_map);
+}
+
 std::vector<MapPerformance> performance_by_map(
     const std::vector<PlayerMatchSummary>& matches) {
+    return performance_by_map(MatchTable::from_matches(matches));
+}
 
-    struct Acc {
-        double total_kda = 0.0;
-        double total_score = 0.0;
-        int wins = 0;
-        int count = 0;
-    };
+AgentMapCrossTab agent_map_crosstab(const MatchTable& table) {
+    return aggregate_matches(table, 0).crosstab;
+}
 
-    std::unordered_map<std::string, Acc> by_map;
-    for (auto& m : matches) {
-        auto& a = by_map[m.map];
-        a.total_kda += m.kda();
-        a.total_score += m.score;
-        a.wins += m.won ? 1 : 0;
-        a.count++;
-    }
+AgentMapCrossTab agent_map_crosstab(const std::vector<PlayerMatchSummary>& matches) {
+    return agent_map_crosstab(MatchTable::from_matches(matches));
+}
 
-    std::vector<MapPerformance> result;
-    for (auto& [map, acc] : by_map) {
-        result.push_back({
-            .map = map,
-            .games = acc.count,
-            .avg_kda = acc.total_kda / acc.count,
-            .win_rate = static_cast<double>(acc.wins) / acc.count,
-            .avg_score = acc.total_score / acc.count,
-        });
-    }
+OverviewStats compute_overview(
+    const MatchTable& table,
+    const std::vector<AgentPerformance>& agents,
+    const std::vector<MapPerformance>& maps) {
 
-    std::ranges::sort(result, std::greater{}, &MapPerformance::games);
-    return result;
+    OverviewAcc acc;
+    for (size_t i = 0; i < table.size(); ++i) {
+        acc.add(table, i, table.damage_per_round(i), table.won(i));
+    }
+    return acc.finish(agents, maps);
 }
 
 OverviewStats compute_overview(
     const std::vector<PlayerMatchSummary>& matches,
     const std::vector<AgentPerformance>& agents,
     const std::vector<MapPerformance>& maps) {
+    return compute_overview(MatchTable::from_matches(matches), agents, maps);
+}
 
-    OverviewStats stats;
-    stats.total_games = static_cast<int>(matches.size());
+namespace {
+
+// Rows per reduction chunk. Fixed, so the summation order (and therefore
+// every floating-point result) does not depend on the number of threads.
+constexpr std::size_t aggregate_chunk_rows = 16384;
 
-    int total_headshots = 0, total_bodyshots = 0, total_legshots = 0;
+struct ChunkAggregates {
+    HourBuckets hours{};
+    HeatmapBuckets heatmap{};
+    std::vector<AgentAcc> by_agent;
+    std::vector<GroupAcc> by_map;
+    std::vector<GridCellAcc> grid; // by_agent.size() x by_map.size(), row-major
+    OverviewAcc overview;
 
-    for (auto& m : matches) {
-        stats.total_kills += m.kills;
-        stats.total_deaths += m.deaths;
-        stats.total_assists += m.assists;
-        stats.total_rr += m.rr_change;
-        if (m.won) stats.wins++;
-        else stats.losses++;
+    ChunkAggregates(std::size_t agents, std::size_t maps)
+        : by_agent(agents), by_map(maps), grid(agents * maps) {}
+
+    GridCellAcc& cell(NameId agent, NameId map) { return grid[agent * by_map.size() + map]; }
+    const GridCellAcc& cell(NameId agent, NameId map) const {
+        return grid[agent * by_map.size() + map];
     }
 
-    if (stats.total_deaths > 0) {
-        stats.overall_kda = static_cast<double>(stats.total_kills + stats.total_assists)
-                            / stats.total_deaths;
-    } else {
-        stats.overall_kda = static_cast<double>(stats.total_kills + stats.total_assists);
+    // Tables interned after this one was sized may carry higher ids
+    void grow(std::size_t agents, std::size_t maps) {
+        agents = std::max(agents, by_agent.size());
+        maps = std::max(maps, by_map.size());
+        if (agents == by_agent.size() && maps == by_map.size()) return;
+
+        std::vector<GridCellAcc> wider(agents * maps);
+        for (size_t a = 0; a < by_agent.size(); ++a) {
+            for (size_t m = 0; m < by_map.size(); ++m) {
+                wider[a * maps + m] = grid[a * by_map.size() + m];
+            }
+        }
+        grid = std::move(wider);
+        by_agent.resize(agents);
+        by_map.resize(maps);
     }
 
-    if (stats.total_games > 0) {
-        stats.win_rate = static_cast<double>(stats.wins) / stats.total_games;
+    void add(const MatchTable& table, size_t i, double kda, double dpr, bool won) {
+        hours[table.local_hour[i]].add(kda, 0.0, won);
+        add_heatmap(heatmap, table, i, kda, won);
+        by_agent[table.agent_id[i]].add(kda, dpr, won);
+        by_map[table.map_id[i]].add(kda, table.score[i], won);
+        cell(table.agent_id[i], table.map_id[i]).add(kda, dpr, won);
+        overview.add(table, i, dpr, won);
     }
 
-    double total_dpr = 0.0;
-    for (auto& m : matches) total_dpr += m.damage_per_round();
-    if (stats.total_games > 0) stats.avg_damage_per_round = total_dpr / stats.total_games;
-
-    // Best agent by KDA (min 3 games)
-    for (auto& a : agents) {
-        if (a.games >= 3 && a.avg_kda > stats.best_agent_kda) {
-            stats.best_agent = a.agent;
-            stats.best_agent_kda = a.avg_kda;
+    void merge(const ChunkAggregates& next) {
+        grow(next.by_agent.size(), next.by_map.size());
+        for (int h = 0; h < 24; ++h) hours[h].merge(next.hours[h]);
+        for (size_t c = 0; c < heatmap.size(); ++c) heatmap[c].merge(next.heatmap[c]);
+        for (size_t id = 0; id < next.by_agent.size(); ++id) by_agent[id].merge(next.by_agent[id]);
+        for (size_t id = 0; id < next.by_map.size(); ++id) by_map[id].merge(next.by_map[id]);
+        for (size_t a = 0; a < next.by_agent.size(); ++a) {
+            for (size_t m = 0; m < next.by_map.size(); ++m) {
+                grid[a * by_map.size() + m].merge(next.grid[a * next.by_map.size() + m]);
+            }
         }
+        overview.merge(next.overview);
+    }
+};
+
+// Rolling KDA and win rate, fed rows in order; a prefix scan, so it cannot
+// be split into chunks. Same add-then-subtract order as rolling_metrics, for
+// identical sums.
+struct RollingAcc {
+    int eff;
+    double kda_sum = 0.0;
+    double win_sum = 0.0;
+    RollingSeries kda;
+    RollingSeries wr;
+
+    RollingAcc(const MatchTable& table, int window)
+        : eff(std::max(std::min(window, static_cast<int>(table.size())), 0)),
+          kda{.values = std::pmr::vector<double>(table.resource())},
+          wr{.values = std::pmr::vector<double>(table.resource())} {
+        if (eff == 0) return;
+        kda.first_index = wr.first_index = eff - 1;
+        kda.values.reserve(table.size() - eff + 1);
+        wr.values.reserve(table.size() - eff + 1);
     }
 
-    // Worst map by WR (min 3 games)
-    for (auto& m : maps) {
-        if (m.games >= 3 && m.win_rate < stats.worst_map_wr) {
-            stats.worst_map = m.map;
-            stats.worst_map_wr = m.win_rate;
+    void add(const MatchTable& table, int i, double row_kda, bool won) {
+        if (eff == 0) return;
+        kda_sum += row_kda;
+        win_sum += won ? 1.0 : 0.0;
+        if (i >= eff) {
+            kda_sum -= table.kda(i - eff);
+            win_sum -= table.won(i - eff) ? 1.0 : 0.0;
+        }
+        if (i >= eff - 1) {
+            kda.values.push_back(kda_sum / eff);
+            wr.values.push_back(win_sum / eff);
         }
     }
+};
 
-    // Streaks
-    int cur_streak = 0;
-    int max_win = 0, max_loss = 0;
-    for (auto& m : matches) {
-        if (m.won) {
-            cur_streak = cur_streak > 0 ? cur_streak + 1 : 1;
-            max_win = std::max(max_win, cur_streak);
-        } else {
-            cur_streak = cur_streak < 0 ? cur_streak - 1 : -1;
-            max_loss = std::max(max_loss, std::abs(cur_streak));
+// `rolling`, when given, is fed every row too, so a serial caller gets the
+// rolling series from the same pass.
+ChunkAggregates aggregate_chunk(const MatchTable& table, size_t begin, size_t end,
+                                size_t agents, size_t maps, RollingAcc* rolling = nullptr) {
+    ChunkAggregates acc(agents, maps);
+    for (size_t i = begin; i < end; ++i) {
+        double kda = table.kda(i);
+        double dpr = table.damage_per_round(i);
+        bool won = table.won(i);
+
+        acc.add(table, i, kda, dpr, won);
+        if (rolling) rolling->add(table, static_cast<int>(i), kda, won);
+    }
+    return acc;
+}
+
+RollingAcc rolling_kda_wr(const MatchTable& table, int window) {
+    RollingAcc rolling(table, window);
+    for (size_t i = 0; i < table.size(); ++i) {
+        rolling.add(table, static_cast<int>(i), table.kda(i), table.won(i));
+    }
+    return rolling;
+}
+
+// Rows and columns follow the agent and map tables, whose ids come along
+// from played_order rather than being looked up again by name
+AgentMapCrossTab finish_crosstab(const ChunkAggregates& acc, std::span<const NameId> agents,
+                                 std::span<const NameId> maps) {
+    AgentMapCrossTab result;
+    result.cells.reserve(agents.size() * maps.size());
+    for (auto agent : agents) {
+        for (auto map : maps) {
+            auto& sums = acc.cell(agent, map);
+            AgentMapCell cell;
+            if (sums.count > 0) {
+                cell = {
+                    .games = sums.count,
+                    .avg_kda = sums.total_kda / sums.count,
+                    .win_rate = static_cast<double>(sums.wins) / sums.count,
+                    .avg_damage_per_round = sums.total_dpr / sums.count,
+                };
+            }
+            result.cells.push_back(cell);
+        }
+    }
+    return result;
+}
+
+// Everything but the rolling series, which callers keep separately
+MatchAggregates finish_breakdowns(const ChunkAggregates& acc, int total) {
+    auto agent_ids = played_order(acc.by_agent);
+    auto map_ids = played_order(acc.by_map);
+
+    MatchAggregates result;
+    result.hourly = finish_hourly(acc.hours);
+    result.heatmap = finish_heatmap(acc.heatmap);
+    result.agents = finish_agents(acc.by_agent, agent_ids, total);
+    result.maps = finish_maps(acc.by_map, map_ids);
+    result.crosstab = finish_crosstab(acc, agent_ids, map_ids);
+    result.crosstab.agent_totals = result.agents;
+    result.crosstab.map_totals = result.maps;
+    result.overview = acc.overview.finish(result.agents, result.maps);
+    return result;
+}
+
+MatchAggregates finish_aggregates(const ChunkAggregates& acc, int total, RollingAcc rolling) {
+    auto result = finish_breakdowns(acc, total);
+    result.rolling_kda = std::move(rolling.kda);
+    result.rolling_wr = std::move(rolling.wr);
+    return result;
+}
+
+} // namespace
+
+MatchAggregates aggregate_matches(const MatchTable& table, int window) {
+    size_t agents = agent_names().size();
+    size_t maps = map_names().size();
+
+    ChunkAggregates total(agents, maps);
+    RollingAcc rolling(table, window);
+    for (size_t begin = 0; begin < table.size(); begin += aggregate_chunk_rows) {
+        size_t end = std::min(table.size(), begin + aggregate_chunk_rows);
+        total.merge(aggregate_chunk(table, begin, end, agents, maps, &rolling));
+    }
+    return finish_aggregates(total, static_cast<int>(table.size()), std::move(rolling));
+}
+
+MatchAggregates aggregate_matches(const MatchTable& table, int window, ThreadPool& pool) {
+    size_t agents = agent_names().size();
+    size_t maps = map_names().size();
+
+    auto rolling = pool.submit([&] { return rolling_kda_wr(table, window); });
+
+    std::vector<std::future<ChunkAggregates>> parts;
+    for (size_t begin = 0; begin < table.size(); begin += aggregate_chunk_rows) {
+        size_t end = std::min(table.size(), begin + aggregate_chunk_rows);
+        parts.push_back(pool.submit([&table, begin, end, agents, maps] {
+            return aggregate_chunk(table, begin, end, agents, maps);
+        }));
+    }
+
+    // The rolling scan runs as its own task alongside the chunks. Merge in row
+    // order so the result matches the serial overload exactly
+    ChunkAggregates total(agents, maps);
+    for (auto& part : parts) total.merge(part.get());
+    return finish_aggregates(total, static_cast<int>(table.size()), rolling.get());
+}
+
+struct AnalyticsState::Impl {
+    Impl(int window, std::int64_t gap_secs, int min_session_length)
+        : window(window), gap_secs(gap_secs), min_session_length(min_session_length),
+          kda_ring(std::max(window, 0)), won_ring(std::max(window, 0)) {}
+
+    int window;
+    std::int64_t gap_secs;
+    int min_session_length;
+
+    ChunkAggregates acc{0, 0}; // grows as names are interned
+    std::size_t count = 0;
+
+    // Last `window` rows, indexed by row % window
+    std::vector<double> kda_ring;
+    std::vector<std::uint8_t> won_ring;
+    double kda_sum = 0.0;
+    double win_sum = 0.0;
+    RollingSeries rolling_kda;
+    RollingSeries rolling_wr;
+
+    std::vector<SessionPerformance> sessions; // back() is still open
+    double open_kda_total = 0.0;
+    std::int64_t last_end = 0;
+    DecayAccumulator closed_decay{true}; // sessions that can no longer grow
+
+    void add_rolling(double kda, bool won) {
+        if (window <= 0) return; // the batch functions return empty series too
+        auto i = count - 1;
+        auto slot = i % window;
+        kda_sum += kda;
+        win_sum += won ? 1.0 : 0.0;
+        if (i >= static_cast<std::size_t>(window)) {
+            kda_sum -= kda_ring[slot];
+            win_sum -= won_ring[slot] ? 1.0 : 0.0;
+        }
+        kda_ring[slot] = kda;
+        won_ring[slot] = won;
+
+        // Until a full window exists the batch version emits one point
+        // averaged over everything seen, so replace rather than append
+        auto eff = std::min<std::size_t>(window, count);
+        if (count <= static_cast<std::size_t>(window)) {
+            rolling_kda.values.clear();
+            rolling_wr.values.clear();
+        }
+        rolling_kda.first_index = rolling_wr.first_index = static_cast<int>(eff) - 1;
+        rolling_kda.values.push_back(kda_sum / eff);
+        rolling_wr.values.push_back(win_sum / eff);
+    }
+
+    void close_session() {
+        if (sessions.empty()) return;
+        auto& sp = sessions.back();
+        if (sp.game_count < min_session_length) return;
+        for (auto& g : sp.games) closed_decay.add(g.game_number, g.kda);
+    }
+
+    void add_session_game(const MatchTable& table, size_t i, double kda) {
+        if (sessions.empty() || table.start[i] - last_end > gap_secs) {
+            close_session();
+            SessionPerformance sp;
+            sp.session_index = static_cast<int>(sessions.size());
+            sessions.push_back(std::move(sp));
+            open_kda_total = 0.0;
         }
+        last_end = table.end(i);
+
+        auto& sp = sessions.back();
+        sp.game_count++;
+        sp.total_rr += table.rr_change[i];
+        open_kda_total += kda;
+        sp.games.push_back({
+            .game_number = sp.game_count,
+            .kda = kda,
+            .damage_per_round = table.damage_per_round(i),
+            .rr_change = table.rr_change[i],
+        });
+        sp.avg_rr_per_game = static_cast<double>(sp.total_rr) / sp.game_count;
+        sp.avg_kda = open_kda_total / sp.game_count;
+    }
+
+    void add(const MatchTable& table, size_t i) {
+        double kda = table.kda(i);
+        double dpr = table.damage_per_round(i);
+        bool won = table.won(i);
+
+        // New names may have been interned since the last ingest
+        if (table.agent_id[i] >= acc.by_agent.size() || table.map_id[i] >= acc.by_map.size()) {
+            acc.grow(agent_names().size(), map_names().size());
+        }
+
+        acc.add(table, i, kda, dpr, won);
+        ++count;
+
+        add_rolling(kda, won);
+        add_session_game(table, i, kda);
     }
-    stats.longest_win_streak = max_win;
-    stats.longest_loss_streak = max_loss;
-    stats.current_streak = cur_streak;
+};
+
+AnalyticsState::AnalyticsState(int window, std::chrono::minutes gap_threshold,
+                               int min_session_length)
+    : impl_(std::make_unique<Impl>(
+          window,
+          std::chrono::duration_cast<std::chrono::seconds>(gap_threshold).count(),
+          min_session_length)) {}
+
+AnalyticsState::~AnalyticsState() = default;
+AnalyticsState::AnalyticsState(AnalyticsState&&) noexcept = default;
+AnalyticsState& AnalyticsState::operator=(AnalyticsState&&) noexcept = default;
+
+void AnalyticsState::ingest(const MatchTable& table, std::size_t from) {
+    for (size_t i = from; i < table.size(); ++i) impl_->add(table, i);
+}
+
+void AnalyticsState::ingest(const std::vector<PlayerMatchSummary>& matches) {
+    ingest(MatchTable::from_matches(matches));
+}
+
+std::size_t AnalyticsState::match_count() const { return impl_->count; }
+
+OverviewStats AnalyticsState::overview() const {
+    return impl_->acc.overview.finish(agents(), maps());
+}
+
+std::vector<HourlyPerformance> AnalyticsState::hourly() const {
+    return finish_hourly(impl_->acc.hours);
+}
+
+WeekHourHeatmap AnalyticsState::heatmap() const {
+    return finish_heatmap(impl_->acc.heatmap);
+}
+
+std::vector<AgentPerformance> AnalyticsState::agents() const {
+    return finish_agents(impl_->acc.by_agent, static_cast<int>(impl_->count));
+}
+
+std::vector<MapPerformance> AnalyticsState::maps() const {
+    return finish_maps(impl_->acc.by_map);
+}
+
+const RollingSeries& AnalyticsState::rolling_kda() const { return impl_->rolling_kda; }
+const RollingSeries& AnalyticsState::rolling_wr() const { return impl_->rolling_wr; }
+
+const std::vector<SessionPerformance>& AnalyticsState::sessions() const {
+    return impl_->sessions;
+}
+
+DecayCurveModel AnalyticsState::decay(DecayWeighting weighting) const {
+    auto acc = impl_->closed_decay;
+    if (!impl_->sessions.empty()) {
+        auto& open = impl_->sessions.back();
+        if (open.game_count >= impl_->min_session_length) {
+            for (auto& g : open.games) acc.add(g.game_number, g.kda);
+        }
+    }
+    return acc.fit(weighting);
+}
+
+ReportData AnalyticsState::report(DecayWeighting weighting) const {
+    auto breakdowns = finish_breakdowns(impl_->acc, static_cast<int>(impl_->count));
+
+    ReportData report;
+    report.match_count = static_cast<int>(impl_->count);
+    report.overview = std::move(breakdowns.overview);
+    report.hourly = std::move(breakdowns.hourly);
+    report.heatmap = breakdowns.heatmap;
+    report.sessions = impl_->sessions;
+    report.rr_sessions = impl_->sessions;
+    report.rolling_kda = impl_->rolling_kda;
+    report.rolling_wr = impl_->rolling_wr;
+    report.decay = decay(weighting);
+    report.agents = std::move(breakdowns.agents);
+    report.maps = std::move(breakdowns.maps);
+    report.crosstab = std::move(breakdowns.crosstab);
+    report.gap_minutes = static_cast<int>(impl_->gap_secs / 60);
+    report.min_session_length = impl_->min_session_length;
+    return report;
+}
+
+struct BreakdownAccumulator::Impl {
+    ChunkAggregates acc{0, 0};
+    std::size_t count = 0;
+};
+
+BreakdownAccumulator::BreakdownAccumulator() : impl_(std::make_unique<Impl>()) {}
+BreakdownAccumulator::~BreakdownAccumulator() = default;
+BreakdownAccumulator::BreakdownAccumulator(BreakdownAccumulator&&) noexcept = default;
+BreakdownAccumulator& BreakdownAccumulator::operator=(BreakdownAccumulator&&) noexcept = default;
+
+void BreakdownAccumulator::add(const MatchTable& table) {
+    size_t agents = agent_names().size();
+    size_t maps = map_names().size();
+    for (size_t begin = 0; begin < table.size(); begin += aggregate_chunk_rows) {
+        size_t end = std::min(table.size(), begin + aggregate_chunk_rows);
+        impl_->acc.merge(aggregate_chunk(table, begin, end, agents, maps));
+    }
+    impl_->count += table.size();
+}
+
+void BreakdownAccumulator::merge(const BreakdownAccumulator& other) {
+    impl_->acc.merge(other.impl_->acc);
+    impl_->count += other.impl_->count;
+}
+
+std::size_t BreakdownAccumulator::match_count() const { return impl_->count; }
+
+std::vector<HourlyPerformance> BreakdownAccumulator::hourly() const {
+    return finish_hourly(impl_->acc.hours);
+}
+
+WeekHourHeatmap BreakdownAccumulator::heatmap() const {
+    return finish_heatmap(impl_->acc.heatmap);
+}
+
+std::vector<AgentPerformance> BreakdownAccumulator::agents() const {
+    return finish_agents(impl_->acc.by_agent, static_cast<int>(impl_->count));
+}
 
-    return stats;
+std::vector<MapPerformance> BreakdownAccumulator::maps() const {
+    return finish_maps(impl_->acc.by_map);
 }
 
 } // namespace valorant
@@ -3,7 +3,6 @@
 #include <algorithm>
 #include <ctime>
 #include <thread>
-#include <unordered_map>
 
 namespace valorant {
 
@@ -125,9 +124,9 @@ PlayerMatchSummary parse_stored_match(const nlohmann::json& j) {
     auto& stats = j["stats"];
     auto& teams = j["teams"];
 
-    s.match_id = safe_str(meta, "id");
-    s.map = safe_obj_name(meta, "map");
-    s.mode = safe_str(meta, "mode");
+    s.match_id = MatchId::parse(safe_str(meta, "id"));
+    s.map_id = map_names().intern(safe_obj_name(meta, "map"));
+    s.mode_id = mode_names().intern(safe_str(meta, "mode"));
 
     if (meta.contains("started_at") && meta["started_at"].is_string()) {
         s.game_start = parse_iso8601(meta["started_at"].get<std::string>());
@@ -137,7 +136,7 @@ PlayerMatchSummary parse_stored_match(const nlohmann::json& j) {
     s.deaths = safe_int(stats, "deaths");
     s.assists = safe_int(stats, "assists");
     s.score = safe_int(stats, "score");
-    s.agent = safe_obj_name(stats, "character");
+    s.agent_id = agent_names().intern(safe_obj_name(stats, "character"));
 
     if (stats.contains("damage") && stats["damage"].is_object()) {
         s.damage_made = safe_int(stats["damage"], "made");
@@ -170,11 +169,14 @@ PlayerMatchSummary parse_stored_match(const nlohmann::json& j) {
 }
 
 std::expected<std::vector<PlayerMatchSummary>, ApiError> fetch_stored_matches(
-    const ClientConfig& config, RateLimiter& limiter,
+    const ClientConfig& config, RateLimiter& limiter, Cache& cache,
     const std::string& region, const std::string& name, const std::string& tag,
-    int count, ProgressCallback on_progress) {
+    const std::string& puuid, int count, ProgressCallback on_progress) {
 
     std::vector<PlayerMatchSummary> all;
+    if (count <= 0) return all;
+
+    MatchIdMap<bool> seen(static_cast<std::size_t>(count));
     constexpr int page_size = 50;
     int pages_needed = (count + page_size - 1) / page_size;
 
@@ -196,7 +198,15 @@ std::expected<std::vector<PlayerMatchSummary>, ApiError> fetch_stored_matches(
         if (!data.is_array() || data.empty()) break;
 
         for (auto& match_json : data) {
-            all.push_back(parse_stored_match(match_json));
+            auto summary = parse_stored_match(match_json);
+            // Pages can shift while we fetch; skip matches already seen
+            if (!summary.match_id.empty()) {
+                if (!seen.try_emplace(summary.match_id).second) continue;
+                // Match records never change, so only new ones are written
+                auto id = summary.match_id.to_string();
+                if (!cache.has_match(id)) cache.store_match(id, match_json);
+            }
+            all.push_back(std::move(summary));
         }
 
         if (on_progress) {
@@ -207,12 +217,36 @@ std::expected<std::vector<PlayerMatchSummary>, ApiError> fetch_stored_matches(
     }
 
     std::ranges::sort(all, {}, &PlayerMatchSummary::game_start);
+
+    // Keep older ids the API no longer returns so the cached history only grows
+    std::vector<std::string> ids;
+    ids.reserve(all.size());
+    for (auto& s : all) ids.push_back(s.match_id.to_string());
+    cache.append_player_matches(puuid, ids);
+
     return all;
 }
 
+std::vector<PlayerMatchSummary> load_cached_matches(
+    const Cache& cache, const std::string& puuid) {
+
+    std::vector<PlayerMatchSummary> matches;
+    auto ids = cache.get_player_matches(puuid);
+    if (!ids) return matches;
+
+    for (auto& id : *ids) {
+        if (auto j = cache.get_match(id, CacheRead::Transient)) {
+            matches.push_back(parse_stored_match(*j));
+        }
+    }
+
+    std::ranges::sort(matches, {}, &PlayerMatchSummary::game_start);
+    return matches;
+}
+
 MmrHistoryEntry parse_mmr_entry(const nlohmann::json& j) {
     MmrHistoryEntry entry;
-    entry.match_id = safe_str(j, "match_id");
+    entry.match_id = MatchId::parse(safe_str(j, "match_id"));
     entry.rr_change = safe_int(j, "mmr_change_to_last_game");
     entry.rr_after = safe_int(j, "elo");
     entry.tier_after = safe_int(j, "currenttier");
@@ -256,15 +290,14 @@ void apply_rr_to_summaries(
     std::vector<PlayerMatchSummary>& summaries,
     const std::vector<MmrHistoryEntry>& mmr_history) {
 
-    std::unordered_map<std::string, int> rr_by_match;
+    MatchIdMap<int> rr_by_match(mmr_history.size());
     for (auto& entry : mmr_history) {
-        rr_by_match[entry.match_id] = entry.rr_change;
+        rr_by_match.insert_or_assign(entry.match_id, entry.rr_change);
     }
 
     for (auto& s : summaries) {
-        auto it = rr_by_match.find(s.match_id);
-        if (it != rr_by_match.end()) {
-            s.rr_change = it->second;
+        if (auto rr = rr_by_match.find(s.match_id)) {
+            s.rr_change = *rr;
             s.rr_available = true;
         }
     }
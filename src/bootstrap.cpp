@@ -0,0 +1,100 @@
+#include "valorant/bootstrap.hpp"
+#include "valorant/analytics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+namespace valorant {
+
+namespace {
+
+constexpr std::uint64_t golden_gamma = 0x9e3779b97f4a7c15ull;
+
+// SplitMix64 output function.
+std::uint64_t mix64(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// Counter-based draws: the value for (key, counter) is a pure function, i.e.
+// SplitMix64 jumped straight to position `counter`.
+struct CounterRng {
+    std::uint64_t key;
+
+    CounterRng(std::uint64_t seed, std::uint64_t stream)
+        : key(mix64(seed + golden_gamma * (stream + 1))) {}
+
+    // Uniform in [0, bound) by multiply-shift (bias is negligible at our sizes)
+    std::uint32_t below(std::uint64_t counter, std::uint32_t bound) const {
+        auto x = mix64(key + golden_gamma * (counter + 1));
+        return static_cast<std::uint32_t>((static_cast<unsigned __int128>(x) * bound) >> 64);
+    }
+};
+
+double quantile(const std::vector<double>& sorted, double q) {
+    double pos = q * (sorted.size() - 1);
+    auto lo = static_cast<std::size_t>(pos);
+    auto hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+}
+
+} // namespace
+
+DecayBootstrap bootstrap_decay_slope(const MatchTable& table,
+                                     const std::vector<Session>& sessions,
+                                     const BootstrapOptions& options,
+                                     ThreadPool& pool) {
+    std::vector<Session> eligible;
+    for (auto& s : sessions) {
+        if (s.game_count() >= options.min_session_length) eligible.push_back(s);
+    }
+
+    DecayBootstrap result;
+    result.confidence = options.confidence;
+    bool valid_confidence = options.confidence > 0.0 && options.confidence < 1.0;
+    if (eligible.size() < 2 || options.replicates <= 0 || !valid_confidence) return result;
+
+    auto session_count = static_cast<std::uint32_t>(eligible.size());
+    auto replicate = [&](int r) {
+        CounterRng rng(options.seed, static_cast<std::uint64_t>(r));
+        DecayAccumulator acc;
+        for (std::uint32_t draw = 0; draw < session_count; ++draw) {
+            acc.add_session(table, eligible[rng.below(draw, session_count)]);
+        }
+        auto model = acc.fit(options.weighting);
+        // A resample with fewer than two positions has no slope
+        return model.points.size() >= 2 ? model.slope : std::nan("");
+    };
+
+    std::vector<double> slopes(options.replicates);
+    int chunk = std::max(1, options.replicates / static_cast<int>(pool.size() * 4 + 1));
+    std::vector<std::future<void>> parts;
+    for (int begin = 0; begin < options.replicates; begin += chunk) {
+        int end = std::min(options.replicates, begin + chunk);
+        parts.push_back(pool.submit([&, begin, end] {
+            for (int r = begin; r < end; ++r) slopes[r] = replicate(r);
+        }));
+    }
+    for (auto& part : parts) part.get();
+
+    std::erase_if(slopes, [](double s) { return std::isnan(s); });
+    if (slopes.empty()) return result;
+    std::ranges::sort(slopes);
+
+    double tail = (1.0 - options.confidence) / 2.0;
+    result.replicates = static_cast<int>(slopes.size());
+    result.ci_low = quantile(slopes, tail);
+    result.ci_high = quantile(slopes, 1.0 - tail);
+
+    auto non_positive = std::ranges::upper_bound(slopes, 0.0) - slopes.begin();
+    auto non_negative = slopes.end() - std::ranges::lower_bound(slopes, 0.0);
+    // (k + 1) / (B + 1) counts the observed slope as one of the replicates,
+    // so the p-value never reaches zero with a finite number of resamples
+    double smaller_tail = static_cast<double>(std::min(non_positive, non_negative) + 1) /
+                          static_cast<double>(slopes.size() + 1);
+    result.p_value = std::min(1.0, 2.0 * smaller_tail);
+    return result;
+}
+
+} // namespace valorant
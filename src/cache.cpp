@@ -1,56 +1,709 @@
 #include "valorant/cache.hpp"
+#include "valorant/crc32c.hpp"
+#include "valorant/match_id.hpp"
+#include "valorant/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <unistd.h>
 
 namespace valorant {
 
-Cache::Cache(std::filesystem::path base_dir) : base_dir_(std::move(base_dir)) {
-    std::filesystem::create_directories(base_dir_ / "matches");
-    std::filesystem::create_directories(base_dir_ / "mmr_history");
+namespace {
+
+// Record framing: "VFC1" | u32 payload length | u32 CRC32C(payload) | payload.
+// Integers are stored in host byte order (little-endian on all supported targets).
+constexpr char record_magic[4] = {'V', 'F', 'C', '1'};
+constexpr std::size_t header_size = 12;
+
+enum class RecordStatus { ok, legacy, corrupt };
+
+struct DecodedRecord {
+    RecordStatus status = RecordStatus::corrupt;
+    std::string_view payload;
+};
+
+DecodedRecord decode_record(std::string_view raw) {
+    if (raw.size() < header_size ||
+        std::memcmp(raw.data(), record_magic, sizeof(record_magic)) != 0) {
+        return {RecordStatus::legacy, raw};
+    }
+
+    std::uint32_t length = 0, crc = 0;
+    std::memcpy(&length, raw.data() + 4, 4);
+    std::memcpy(&crc, raw.data() + 8, 4);
+
+    auto payload = raw.substr(header_size);
+    if (payload.size() != length) return {};
+    if (crc32c(payload.data(), payload.size()) != crc) return {};
+    return {RecordStatus::ok, payload};
+}
+
+std::string encode_record(const std::string& payload) {
+    auto length = static_cast<std::uint32_t>(payload.size());
+    auto crc = crc32c(payload.data(), payload.size());
+
+    std::string out;
+    out.reserve(header_size + payload.size());
+    out.append(record_magic, sizeof(record_magic));
+    out.append(reinterpret_cast<const char*>(&length), 4);
+    out.append(reinterpret_cast<const char*>(&crc), 4);
+    out.append(payload);
+    return out;
+}
+
+std::optional<std::string> read_file(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return std::nullopt;
+    return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+constexpr std::string_view ns_matches = "matches";
+constexpr std::string_view ns_mmr = "mmr_history";
+constexpr std::string_view ns_players = "players";
+constexpr std::string_view all_namespaces[] = {ns_matches, ns_mmr, ns_players};
+
+// Memory entries loaded from an attached bundle; never matches an index seq.
+constexpr std::uint64_t bundle_seq = ~std::uint64_t{0};
+
+std::filesystem::file_time_type from_ticks(std::int64_t ticks) {
+    return std::filesystem::file_time_type(std::filesystem::file_time_type::duration(ticks));
+}
+
+std::int64_t to_unix_seconds(std::filesystem::file_time_type t) {
+    auto sys = std::chrono::file_clock::to_sys(t);
+    return std::chrono::floor<std::chrono::seconds>(sys).time_since_epoch().count();
+}
+
+std::filesystem::file_time_type from_unix_seconds(std::int64_t secs) {
+    return std::chrono::file_clock::from_sys(
+        std::chrono::sys_seconds{std::chrono::seconds{secs}});
+}
+
+bool expired(std::filesystem::file_time_type written, std::chrono::minutes ttl) {
+    auto file_age = std::filesystem::file_time_type::clock::now() - written;
+    return std::chrono::duration_cast<std::chrono::minutes>(file_age) > ttl;
+}
+
+// Sets `corrupt` when the file exists but fails its length, CRC or JSON
+// check, so callers can tell damage apart from a plain miss.
+std::optional<nlohmann::json> parse_file(const std::filesystem::path& path,
+                                         std::uint64_t& bytes_read, bool& corrupt) {
+    auto raw = read_file(path);
+    if (!raw) return std::nullopt;
+    bytes_read += raw->size();
+
+    // A checksum mismatch is rejected before paying for a parse.
+    auto rec = decode_record(*raw);
+    if (rec.status != RecordStatus::corrupt) {
+        auto data = nlohmann::json::parse(rec.payload, nullptr, false);
+        if (!data.is_discarded()) return data;
+    }
+    corrupt = true;
+    return std::nullopt;
+}
+
+RecordStatus check_file(const std::filesystem::path& path) {
+    auto raw = read_file(path);
+    if (!raw) return RecordStatus::corrupt;
+
+    auto rec = decode_record(*raw);
+    if (rec.status == RecordStatus::legacy &&
+        !nlohmann::json::accept(rec.payload)) {
+        return RecordStatus::corrupt;
+    }
+    return rec.status;
+}
+
+std::size_t ns_slot(std::string_view ns) {
+    for (std::size_t i = 0; i < std::size(all_namespaces); ++i) {
+        if (all_namespaces[i] == ns) return i;
+    }
+    return 0;
+}
+
+struct AtomicHistogram {
+    std::array<std::atomic<std::uint64_t>, LatencyHistogram::bucket_count> buckets{};
+    std::atomic<std::uint64_t> samples{0};
+    std::atomic<std::uint64_t> total_us{0};
+
+    void record(std::chrono::steady_clock::duration d) {
+        auto us = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+        auto bucket = std::min<std::size_t>(std::bit_width(us), LatencyHistogram::bucket_count - 1);
+        buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        samples.fetch_add(1, std::memory_order_relaxed);
+        total_us.fetch_add(us, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram snapshot() const {
+        LatencyHistogram h;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            h.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        }
+        h.samples = samples.load(std::memory_order_relaxed);
+        h.total_us = total_us.load(std::memory_order_relaxed);
+        return h;
+    }
+};
+
+struct NamespaceCounters {
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> expired{0};
+    std::atomic<std::uint64_t> corrupt{0};
+    std::atomic<std::uint64_t> bytes_read{0};
+    std::atomic<std::uint64_t> bytes_written{0};
+    std::atomic<std::uint64_t> writes{0};
+    AtomicHistogram read_latency;
+    AtomicHistogram write_latency;
+};
+
+} // namespace
+
+struct Cache::Counters {
+    std::array<NamespaceCounters, std::size(all_namespaces)> ns;
+};
+
+std::uint64_t LatencyHistogram::percentile_us(double q) const {
+    if (samples == 0) return 0;
+    auto target = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(samples)));
+    std::uint64_t seen = 0;
+    for (int i = 0; i < bucket_count; ++i) {
+        seen += buckets[i];
+        if (seen >= target && buckets[i] > 0) return std::uint64_t{1} << i;
+    }
+    return std::uint64_t{1} << (bucket_count - 1);
+}
+
+Cache::Cache(std::filesystem::path base_dir, std::size_t memory_entries)
+    : base_dir_(std::move(base_dir)), counters_(std::make_unique<Counters>()),
+      memory_capacity_(memory_entries) {
+    for (auto ns : all_namespaces) {
+        std::filesystem::create_directories(base_dir_ / ns);
+    }
+
+    index_ = std::make_unique<SharedIndex>(
+        base_dir_ / "index.bin", index_capacity_, [this](SharedIndex& index) {
+            for (auto ns : all_namespaces) {
+                for (auto& entry : std::filesystem::directory_iterator(base_dir_ / ns)) {
+                    if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+                    index.publish(ns, entry.path().stem().string(),
+                                  entry.last_write_time().time_since_epoch().count(),
+                                  entry.file_size());
+                }
+            }
+        });
 }
 
-std::optional<nlohmann::json> Cache::get_match(const std::string& match_id) const {
-    return read_json(base_dir_ / "matches" / (match_id + ".json"));
+Cache::~Cache() = default;
+
+std::optional<nlohmann::json> Cache::get_match(const std::string& match_id,
+                                               CacheRead mode) const {
+    return read_json(ns_matches, match_id, std::nullopt, mode);
 }
 
 void Cache::store_match(const std::string& match_id, const nlohmann::json& data) {
-    write_json(base_dir_ / "matches" / (match_id + ".json"), data);
+    write_json(ns_matches, match_id, data);
+}
+
+bool Cache::has_match(const std::string& match_id) const {
+    if (index_->authoritative()) return index_->find(ns_matches, match_id).has_value();
+    std::error_code ec;
+    return std::filesystem::exists(record_path(ns_matches, match_id), ec);
 }
 
 std::optional<nlohmann::json> Cache::get_mmr_history(const std::string& puuid) const {
-    return read_json(base_dir_ / "mmr_history" / (puuid + ".json"), mmr_ttl_);
+    return read_json(ns_mmr, puuid, mmr_ttl_);
 }
 
 void Cache::store_mmr_history(const std::string& puuid, const nlohmann::json& data) {
-    write_json(base_dir_ / "mmr_history" / (puuid + ".json"), data);
+    write_json(ns_mmr, puuid, data);
+}
+
+std::optional<std::vector<std::string>> Cache::get_player_matches(const std::string& puuid) const {
+    auto data = read_json(ns_players, puuid);
+    if (!data || !data->is_array()) return std::nullopt;
+    return data->get<std::vector<std::string>>();
+}
+
+void Cache::store_player_matches(const std::string& puuid,
+                                 const std::vector<std::string>& match_ids) {
+    write_json(ns_players, puuid, match_ids);
+}
+
+void Cache::append_player_matches(const std::string& puuid,
+                                  const std::vector<std::string>& match_ids) {
+    auto guard = index_->lock();
+
+    auto ids = get_player_matches(puuid).value_or(std::vector<std::string>{});
+    MatchIdMap<bool> known(ids.size() + match_ids.size());
+    for (auto& id : ids) known.try_emplace(MatchId::parse(id));
+    for (auto& id : match_ids) {
+        if (known.try_emplace(MatchId::parse(id)).second) ids.push_back(id);
+    }
+
+    write_json_locked(ns_players, puuid, ids);
+}
+
+std::vector<std::string> Cache::recent_players(std::size_t count) const {
+    std::vector<std::pair<std::filesystem::file_time_type, std::string>> players;
+    for (auto& entry : std::filesystem::directory_iterator(base_dir_ / ns_players)) {
+        if (!entry.is_regular_file()) continue;
+        players.emplace_back(entry.last_write_time(), entry.path().stem().string());
+    }
+
+    count = std::min(count, players.size());
+    std::ranges::partial_sort(players, players.begin() + count, std::greater{});
+
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < count; ++i) result.push_back(std::move(players[i].second));
+    return result;
+}
+
+std::size_t Cache::warm_up(const std::vector<std::string>& puuids) const {
+    using Records = std::vector<std::pair<std::string_view, std::string>>;
+    ThreadPool pool;
+    auto preload_all = [&](const Records& records) {
+        std::size_t chunk = std::max<std::size_t>(1, records.size() / (pool.size() * 4) + 1);
+        std::vector<std::future<std::size_t>> parts;
+        for (std::size_t begin = 0; begin < records.size(); begin += chunk) {
+            std::size_t end = std::min(records.size(), begin + chunk);
+            parts.push_back(pool.submit([this, &records, begin, end] {
+                std::size_t loaded = 0;
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (preload(records[i].first, records[i].second)) ++loaded;
+                }
+                return loaded;
+            }));
+        }
+
+        std::size_t loaded = 0;
+        for (auto& part : parts) loaded += part.get();
+        return loaded;
+    };
+
+    Records records;
+    for (auto& puuid : puuids) {
+        records.emplace_back(ns_mmr, puuid);
+        records.emplace_back(ns_players, puuid);
+    }
+    auto loaded = preload_all(records);
+
+    // Then the matches those indexes list, newest first and taking turns
+    // between players, for as long as the memory tier has room
+    std::vector<std::vector<std::string>> id_lists;
+    {
+        std::lock_guard lock(memory_mutex_);
+        for (auto& puuid : puuids) {
+            auto* index = recall(std::string(ns_players) + "/" + puuid);
+            if (index && index->data.is_array()) {
+                id_lists.push_back(index->data.get<std::vector<std::string>>());
+            }
+        }
+    }
+
+    std::size_t budget = memory_capacity_ > loaded ? memory_capacity_ - loaded : 0;
+    records.clear();
+    for (std::size_t depth = 0; records.size() < budget; ++depth) {
+        bool more = false;
+        for (auto& ids : id_lists) {
+            if (depth >= ids.size() || records.size() == budget) continue;
+            records.emplace_back(ns_matches, ids[ids.size() - 1 - depth]);
+            more = true;
+        }
+        if (!more) break;
+    }
+    return loaded + preload_all(records);
+}
+
+CacheVerifyReport Cache::verify() const {
+    {
+        // Resync the shared index with the files on disk; also clears an overflow
+        auto guard = index_->lock();
+        index_->rebuild();
+    }
+
+    std::vector<std::filesystem::path> files;
+    std::vector<std::size_t> file_ns; // slot in all_namespaces of files[i]
+    for (std::size_t n = 0; n < std::size(all_namespaces); ++n) {
+        for (auto& entry : std::filesystem::directory_iterator(base_dir_ / all_namespaces[n])) {
+            if (!entry.is_regular_file()) continue;
+            files.push_back(entry.path());
+            file_ns.push_back(n);
+        }
+    }
+
+    ThreadPool pool;
+    std::size_t chunk = std::max<std::size_t>(1, files.size() / (pool.size() * 4) + 1);
+    std::vector<std::future<std::vector<RecordStatus>>> parts;
+    for (std::size_t begin = 0; begin < files.size(); begin += chunk) {
+        std::size_t end = std::min(files.size(), begin + chunk);
+        parts.push_back(pool.submit([&files, begin, end] {
+            std::vector<RecordStatus> statuses;
+            statuses.reserve(end - begin);
+            for (std::size_t i = begin; i < end; ++i) {
+                statuses.push_back(check_file(files[i]));
+            }
+            return statuses;
+        }));
+    }
+
+    CacheVerifyReport report;
+    for (auto ns : all_namespaces) report.corrupt_by_namespace.emplace_back(ns, 0);
+    std::size_t i = 0;
+    for (auto& part : parts) {
+        for (auto status : part.get()) {
+            report.scanned++;
+            switch (status) {
+                case RecordStatus::ok: report.ok++; break;
+                case RecordStatus::legacy: report.legacy++; break;
+                case RecordStatus::corrupt:
+                    report.corrupt++;
+                    report.corrupt_by_namespace[file_ns[i]].second++;
+                    report.corrupt_files.push_back(files[i]);
+                    break;
+            }
+            ++i;
+        }
+    }
+
+    std::ranges::sort(report.corrupt_files);
+    return report;
+}
+
+CacheStats Cache::stats() const {
+    CacheStats stats;
+    for (std::size_t i = 0; i < std::size(all_namespaces); ++i) {
+        auto& c = counters_->ns[i];
+        stats.namespaces.push_back({
+            .name = std::string(all_namespaces[i]),
+            .hits = c.hits.load(std::memory_order_relaxed),
+            .misses = c.misses.load(std::memory_order_relaxed),
+            .expired = c.expired.load(std::memory_order_relaxed),
+            .corrupt = c.corrupt.load(std::memory_order_relaxed),
+            .bytes_read = c.bytes_read.load(std::memory_order_relaxed),
+            .bytes_written = c.bytes_written.load(std::memory_order_relaxed),
+            .writes = c.writes.load(std::memory_order_relaxed),
+            .read_latency = c.read_latency.snapshot(),
+            .write_latency = c.write_latency.snapshot(),
+        });
+    }
+    return stats;
+}
+
+std::optional<std::size_t> Cache::export_bundle(const std::filesystem::path& file) const {
+    std::vector<BundleRecord> records;
+    for (auto ns : all_namespaces) {
+        for (auto& entry : std::filesystem::directory_iterator(base_dir_ / ns)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+
+            auto raw = read_file(entry.path());
+            if (!raw) continue;
+
+            auto rec = decode_record(*raw);
+            std::string payload;
+            if (rec.status == RecordStatus::ok) {
+                payload = rec.payload;
+            } else if (rec.status == RecordStatus::legacy) {
+                auto j = nlohmann::json::parse(rec.payload, nullptr, false);
+                if (j.is_discarded()) continue;
+                payload = j.dump();
+            } else {
+                continue;
+            }
+
+            records.push_back({
+                .ns = std::string(ns),
+                .key = entry.path().stem().string(),
+                .payload = std::move(payload),
+                .written = to_unix_seconds(entry.last_write_time()),
+            });
+        }
+    }
+
+    std::ranges::sort(records, [](const BundleRecord& a, const BundleRecord& b) {
+        return std::tie(a.ns, a.key) < std::tie(b.ns, b.key);
+    });
+
+    if (!write_bundle(file, records)) return std::nullopt;
+    return records.size();
+}
+
+std::optional<std::size_t> Cache::import_bundle(const std::filesystem::path& file) {
+    auto bundle = CacheBundle::open(file);
+    if (!bundle) return std::nullopt;
+
+    auto guard = index_->lock();
+    std::size_t imported = 0;
+
+    for (std::size_t i = 0; i < bundle->size(); ++i) {
+        auto rec = bundle->at(i);
+        if (!rec || std::ranges::find(all_namespaces, rec->ns) == std::end(all_namespaces)) {
+            continue;
+        }
+
+        auto data = nlohmann::json::parse(rec->payload, nullptr, false);
+        if (data.is_discarded()) continue;
+
+        if (rec->ns == ns_players) {
+            if (!data.is_array()) continue;
+            auto ids = get_player_matches(rec->key).value_or(std::vector<std::string>{});
+            auto before = ids.size();
+            MatchIdMap<bool> known(ids.size() + data.size());
+            for (auto& id : ids) known.try_emplace(MatchId::parse(id));
+            for (auto& id : data) {
+                if (!id.is_string()) continue;
+                auto& text = id.get_ref<const std::string&>();
+                if (known.try_emplace(MatchId::parse(text)).second) ids.push_back(text);
+            }
+            if (ids.size() == before) continue;
+            write_json_locked(ns_players, rec->key, ids);
+            ++imported;
+            continue;
+        }
+
+        // A local record wins unless the bundle's copy was written later
+        std::optional<std::filesystem::file_time_type> local;
+        if (index_->authoritative()) {
+            if (auto entry = index_->find(rec->ns, rec->key)) local = from_ticks(entry->written);
+        } else {
+            std::error_code ec;
+            auto written = std::filesystem::last_write_time(record_path(rec->ns, rec->key), ec);
+            if (!ec) local = written;
+        }
+        if (local && to_unix_seconds(*local) >= rec->written) continue;
+
+        write_json_locked(rec->ns, rec->key, data, from_unix_seconds(rec->written));
+        ++imported;
+    }
+
+    return imported;
+}
+
+bool Cache::attach_bundle(const std::filesystem::path& file) {
+    bundle_ = CacheBundle::open(file);
+    return bundle_ != nullptr;
+}
+
+std::filesystem::path Cache::record_path(std::string_view ns, const std::string& key) const {
+    return base_dir_ / ns / (key + ".json");
 }
 
 std::optional<nlohmann::json> Cache::read_json(
-    const std::filesystem::path& path,
-    std::optional<std::chrono::minutes> ttl) const {
+    std::string_view ns, const std::string& key,
+    std::optional<std::chrono::minutes> ttl, CacheRead mode) const {
+
+    auto start = std::chrono::steady_clock::now();
+    bool was_expired = false;
+    bool was_corrupt = false;
+    std::uint64_t bytes = 0;
+    auto data = load_json(ns, key, ttl, mode, was_expired, was_corrupt, bytes);
+
+    auto& c = counters_->ns[ns_slot(ns)];
+    c.read_latency.record(std::chrono::steady_clock::now() - start);
+    (data ? c.hits : c.misses).fetch_add(1, std::memory_order_relaxed);
+    if (was_expired) c.expired.fetch_add(1, std::memory_order_relaxed);
+    if (was_corrupt) c.corrupt.fetch_add(1, std::memory_order_relaxed);
+    if (bytes) c.bytes_read.fetch_add(bytes, std::memory_order_relaxed);
+    return data;
+}
 
-    if (!std::filesystem::exists(path)) return std::nullopt;
+std::optional<nlohmann::json> Cache::load_json(
+    std::string_view ns, const std::string& key,
+    std::optional<std::chrono::minutes> ttl, CacheRead mode,
+    bool& was_expired, bool& was_corrupt, std::uint64_t& bytes_read) const {
 
-    if (ttl) {
-        auto file_time = std::filesystem::last_write_time(path);
-        auto file_age = std::filesystem::file_time_type::clock::now() - file_time;
-        auto age = std::chrono::duration_cast<std::chrono::minutes>(file_age);
-        if (age > *ttl) return std::nullopt;
+    // With an authoritative index, a miss or an expired entry never touches disk
+    std::optional<SharedIndex::Entry> entry;
+    if (index_->authoritative()) {
+        entry = index_->find(ns, key);
+        if (!entry) return load_from_bundle(ns, key, ttl, mode, was_expired, was_corrupt, bytes_read);
+        if (ttl && expired(from_ticks(entry->written), *ttl)) {
+            was_expired = true;
+            return std::nullopt;
+        }
     }
 
-    std::ifstream file(path);
-    if (!file.is_open()) return std::nullopt;
+    auto mem_key = std::string(ns) + "/" + key;
+    {
+        std::lock_guard lock(memory_mutex_);
+        if (auto* cached = recall(mem_key)) {
+            // Another process may have rewritten the record since we read it
+            bool stale = entry && cached->seq != entry->seq;
+            if (!stale) {
+                if (ttl && expired(cached->written, *ttl)) {
+                    forget(mem_key);
+                    was_expired = true;
+                    return std::nullopt;
+                }
+                return cached->data;
+            }
+        }
+    }
+
+    auto path = record_path(ns, key);
+    std::error_code ec;
+    auto written = entry ? from_ticks(entry->written)
+                         : std::filesystem::last_write_time(path, ec);
+    if (ec) return load_from_bundle(ns, key, ttl, mode, was_expired, was_corrupt, bytes_read);
+    if (ttl && expired(written, *ttl)) {
+        was_expired = true;
+        return std::nullopt;
+    }
+
+    auto data = parse_file(path, bytes_read, was_corrupt);
+    if (!data || mode == CacheRead::Transient) return data;
+
+    std::lock_guard lock(memory_mutex_);
+    remember(mem_key, {*data, written, entry ? entry->seq : 0});
+    return data;
+}
+
+std::optional<nlohmann::json> Cache::load_from_bundle(
+    std::string_view ns, const std::string& key,
+    std::optional<std::chrono::minutes> ttl, CacheRead mode,
+    bool& was_expired, bool& was_corrupt, std::uint64_t& bytes_read) const {
+
+    if (!bundle_) return std::nullopt;
+
+    auto mem_key = std::string(ns) + "/" + key;
+    {
+        std::lock_guard lock(memory_mutex_);
+        if (auto* cached = recall(mem_key); cached && cached->seq == bundle_seq) {
+            if (ttl && expired(cached->written, *ttl)) {
+                was_expired = true;
+                return std::nullopt;
+            }
+            return cached->data;
+        }
+    }
+
+    auto rec = bundle_->find(ns, key);
+    if (!rec) return std::nullopt;
+
+    auto written = from_unix_seconds(rec->written);
+    if (ttl && expired(written, *ttl)) {
+        was_expired = true;
+        return std::nullopt;
+    }
 
-    try {
-        return nlohmann::json::parse(file);
-    } catch (...) {
+    bytes_read += rec->payload.size();
+    auto data = nlohmann::json::parse(rec->payload, nullptr, false);
+    if (data.is_discarded()) {
+        was_corrupt = true;
         return std::nullopt;
     }
+    if (mode == CacheRead::Transient) return data;
+
+    std::lock_guard lock(memory_mutex_);
+    remember(mem_key, {data, written, bundle_seq});
+    return data;
+}
+
+bool Cache::preload(std::string_view ns, const std::string& key) const {
+    std::optional<SharedIndex::Entry> entry;
+    if (index_->authoritative()) {
+        entry = index_->find(ns, key);
+        if (!entry) return false;
+    }
+
+    auto path = record_path(ns, key);
+    std::error_code ec;
+    auto written = entry ? from_ticks(entry->written)
+                         : std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+
+    std::uint64_t bytes = 0;
+    bool corrupt = false;
+    auto data = parse_file(path, bytes, corrupt);
+    auto& c = counters_->ns[ns_slot(ns)];
+    c.bytes_read.fetch_add(bytes, std::memory_order_relaxed);
+    if (corrupt) c.corrupt.fetch_add(1, std::memory_order_relaxed);
+    if (!data) return false;
+
+    std::lock_guard lock(memory_mutex_);
+    remember(std::string(ns) + "/" + key, {std::move(*data), written, entry ? entry->seq : 0});
+    return true;
+}
+
+void Cache::write_json(std::string_view ns, const std::string& key,
+                       const nlohmann::json& data) const {
+    auto guard = index_->lock();
+    write_json_locked(ns, key, data);
+}
+
+void Cache::write_json_locked(std::string_view ns, const std::string& key,
+                              const nlohmann::json& data,
+                              std::optional<std::filesystem::file_time_type> written_at) const {
+    auto start = std::chrono::steady_clock::now();
+    auto path = record_path(ns, key);
+    auto tmp = path;
+    tmp += ".tmp" + std::to_string(::getpid());
+
+    auto record = encode_record(data.dump());
+    {
+        std::ofstream file(tmp, std::ios::binary);
+        if (!file.is_open()) return;
+        file << record;
+        if (!file) return;
+    }
+
+    std::error_code ec;
+    if (written_at) std::filesystem::last_write_time(tmp, *written_at, ec);
+
+    // Readers in other processes see either the old or the new record, never a torn one
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return;
+    }
+
+    auto written = std::filesystem::last_write_time(path, ec);
+    if (ec) return;
+
+    auto entry = index_->publish(ns, key, written.time_since_epoch().count(), record.size());
+
+    auto& c = counters_->ns[ns_slot(ns)];
+    c.writes.fetch_add(1, std::memory_order_relaxed);
+    c.bytes_written.fetch_add(record.size(), std::memory_order_relaxed);
+    c.write_latency.record(std::chrono::steady_clock::now() - start);
+
+    std::lock_guard lock(memory_mutex_);
+    remember(std::string(ns) + "/" + key, {data, written, entry ? entry->seq : 0});
+}
+
+const Cache::MemoryEntry* Cache::recall(const std::string& mem_key) const {
+    auto it = memory_.find(mem_key);
+    if (it == memory_.end()) return nullptr;
+    memory_lru_.splice(memory_lru_.begin(), memory_lru_, it->second);
+    return &it->second->second;
+}
+
+void Cache::remember(const std::string& mem_key, MemoryEntry entry) const {
+    if (memory_capacity_ == 0) return;
+    if (auto it = memory_.find(mem_key); it != memory_.end()) {
+        it->second->second = std::move(entry);
+        memory_lru_.splice(memory_lru_.begin(), memory_lru_, it->second);
+        return;
+    }
+
+    memory_lru_.emplace_front(mem_key, std::move(entry));
+    memory_.emplace(mem_key, memory_lru_.begin());
+    if (memory_.size() > memory_capacity_) {
+        memory_.erase(memory_lru_.back().first);
+        memory_lru_.pop_back();
+    }
 }
 
-void Cache::write_json(const std::filesystem::path& path, const nlohmann::json& data) const {
-    std::ofstream file(path);
-    if (file.is_open()) {
-        file << data.dump(2);
+void Cache::forget(const std::string& mem_key) const {
+    if (auto it = memory_.find(mem_key); it != memory_.end()) {
+        memory_lru_.erase(it->second);
+        memory_.erase(it);
     }
 }
 
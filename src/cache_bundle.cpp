@@ -0,0 +1,185 @@
+#include "valorant/cache_bundle.hpp"
+#include "valorant/cache_index.hpp"
+#include "valorant/crc32c.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace valorant {
+
+namespace {
+
+constexpr char bundle_magic[8] = {'V', 'F', 'C', 'B', 'N', 'D', 'L', '1'};
+
+// Layout: Header | compressed payloads | Entry[count] sorted by fingerprint |
+// names ("ns/key" strings referenced by entries). Host byte order.
+struct Header {
+    char magic[8];
+    std::uint64_t count;
+    std::uint64_t index_offset;
+    std::uint64_t names_offset;
+};
+
+} // namespace
+
+struct CacheBundle::Entry {
+    std::uint64_t fingerprint;
+    std::uint64_t offset;
+    std::int64_t written;
+    std::uint32_t compressed_size;
+    std::uint32_t raw_size;
+    std::uint32_t crc;
+    std::uint32_t name_offset;
+    std::uint32_t ns_size;
+    std::uint32_t key_size;
+};
+
+bool write_bundle(const std::filesystem::path& file, const std::vector<BundleRecord>& records) {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    Header header{};
+    std::memcpy(header.magic, bundle_magic, sizeof(bundle_magic));
+    header.count = records.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<CacheBundle::Entry> entries;
+    std::string names;
+    std::uint64_t offset = sizeof(header);
+    std::vector<Bytef> buffer;
+
+    for (auto& rec : records) {
+        uLongf compressed_size = compressBound(rec.payload.size());
+        buffer.resize(compressed_size);
+        if (compress2(buffer.data(), &compressed_size,
+                      reinterpret_cast<const Bytef*>(rec.payload.data()),
+                      rec.payload.size(), Z_DEFAULT_COMPRESSION) != Z_OK) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(buffer.data()),
+                  static_cast<std::streamsize>(compressed_size));
+
+        entries.push_back({
+            .fingerprint = record_fingerprint(rec.ns, rec.key),
+            .offset = offset,
+            .written = rec.written,
+            .compressed_size = static_cast<std::uint32_t>(compressed_size),
+            .raw_size = static_cast<std::uint32_t>(rec.payload.size()),
+            .crc = crc32c(rec.payload.data(), rec.payload.size()),
+            .name_offset = static_cast<std::uint32_t>(names.size()),
+            .ns_size = static_cast<std::uint32_t>(rec.ns.size()),
+            .key_size = static_cast<std::uint32_t>(rec.key.size()),
+        });
+        names += rec.ns;
+        names += rec.key;
+        offset += compressed_size;
+    }
+
+    std::ranges::sort(entries, {}, &CacheBundle::Entry::fingerprint);
+
+    header.index_offset = offset;
+    header.names_offset = offset + entries.size() * sizeof(CacheBundle::Entry);
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(CacheBundle::Entry)));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return static_cast<bool>(out);
+}
+
+std::unique_ptr<CacheBundle> CacheBundle::open(const std::filesystem::path& file) {
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    auto size = static_cast<std::size_t>(st.st_size);
+    void* base = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) return nullptr;
+
+    std::unique_ptr<CacheBundle> bundle(new CacheBundle());
+    bundle->base_ = static_cast<const char*>(base);
+    bundle->mapped_size_ = size;
+
+    Header header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, bundle_magic, sizeof(bundle_magic)) != 0 ||
+        header.index_offset < sizeof(Header) || header.index_offset > size ||
+        header.names_offset > size ||
+        header.count > (size - header.index_offset) / sizeof(Entry) ||
+        header.names_offset < header.index_offset + header.count * sizeof(Entry)) {
+        return nullptr;
+    }
+
+    bundle->count_ = header.count;
+    bundle->index_offset_ = header.index_offset;
+    bundle->names_offset_ = header.names_offset;
+    return bundle;
+}
+
+CacheBundle::~CacheBundle() {
+    if (base_) ::munmap(const_cast<char*>(base_), mapped_size_);
+}
+
+// The index follows variable-length payloads, so it is not aligned for Entry;
+// entries are copied out rather than read in place.
+CacheBundle::Entry CacheBundle::entry(std::size_t i) const {
+    Entry e;
+    std::memcpy(&e, base_ + index_offset_ + i * sizeof(Entry), sizeof(Entry));
+    return e;
+}
+
+std::optional<BundleRecord> CacheBundle::find(std::string_view ns, std::string_view key) const {
+    auto fp = record_fingerprint(ns, key);
+    std::size_t lo = 0, hi = count_;
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (entry(mid).fingerprint < fp) lo = mid + 1;
+        else hi = mid;
+    }
+
+    for (; lo < count_ && entry(lo).fingerprint == fp; ++lo) {
+        auto rec = at(lo);
+        if (rec && rec->ns == ns && rec->key == key) return rec;
+    }
+    return std::nullopt;
+}
+
+std::optional<BundleRecord> CacheBundle::at(std::size_t i) const {
+    if (i >= count_) return std::nullopt;
+    auto e = entry(i);
+
+    if (e.offset + e.compressed_size > index_offset_ ||
+        names_offset_ + e.name_offset + e.ns_size + e.key_size > mapped_size_) {
+        return std::nullopt;
+    }
+
+    BundleRecord rec;
+    const char* name = base_ + names_offset_ + e.name_offset;
+    rec.ns.assign(name, e.ns_size);
+    rec.key.assign(name + e.ns_size, e.key_size);
+    rec.written = e.written;
+
+    rec.payload.resize(e.raw_size);
+    uLongf raw_size = e.raw_size;
+    if (uncompress(reinterpret_cast<Bytef*>(rec.payload.data()), &raw_size,
+                   reinterpret_cast<const Bytef*>(base_ + e.offset), e.compressed_size) != Z_OK ||
+        raw_size != e.raw_size ||
+        crc32c(rec.payload.data(), rec.payload.size()) != e.crc) {
+        return std::nullopt;
+    }
+    return rec;
+}
+
+} // namespace valorant
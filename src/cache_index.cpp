@@ -0,0 +1,377 @@
+#include "valorant/cache_index.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace valorant {
+
+namespace {
+
+constexpr char index_magic[8] = {'V', 'F', 'I', 'D', 'X', '0', '0', '3'};
+
+std::uint64_t load(const std::uint64_t& v) { return __atomic_load_n(&v, __ATOMIC_ACQUIRE); }
+void store(std::uint64_t& v, std::uint64_t x) { __atomic_store_n(&v, x, __ATOMIC_RELEASE); }
+std::uint64_t load_relaxed(const std::uint64_t& v) { return __atomic_load_n(&v, __ATOMIC_RELAXED); }
+void store_relaxed(std::uint64_t& v, std::uint64_t x) { __atomic_store_n(&v, x, __ATOMIC_RELAXED); }
+
+std::uint64_t fnv1a(std::string_view ns, std::string_view key, std::uint64_t h) {
+    auto mix = [&](std::string_view s) {
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 0x100000001b3ull;
+        }
+    };
+    mix(ns);
+    mix(std::string_view("\0", 1));
+    mix(key);
+    return h;
+}
+
+// Independently seeded second hash stored next to the fingerprint, so two
+// keys only share a slot if both 64-bit hashes collide.
+std::uint64_t record_check(std::string_view ns, std::string_view key) {
+    return fnv1a(ns, key, 0x84222325cbf29ce4ull);
+}
+
+} // namespace
+
+std::uint64_t record_fingerprint(std::string_view ns, std::string_view key) {
+    auto h = fnv1a(ns, key, 0xcbf29ce484222325ull);
+    return h == 0 ? 1 : h; // 0 marks an empty slot
+}
+
+struct SharedIndex::Header {
+    char magic[8];          // written last, once the table is fully built
+    std::uint64_t capacity;
+    std::uint64_t next_seq;
+    std::uint64_t used;
+    std::uint64_t overflowed;
+    std::uint64_t retired;  // replaced by a newer file at the same path
+};
+
+struct SharedIndex::Slot {
+    std::uint64_t key;
+    std::uint64_t check;
+    std::uint64_t seq;     // in the table: twice the publish seq, odd mid-update
+    std::uint64_t written;
+    std::uint64_t size;
+};
+
+struct SharedIndex::Mapping {
+    void* base = nullptr;
+    std::size_t size = 0;
+    std::filesystem::path file;
+    ino_t inode = 0;
+    dev_t device = 0;
+
+    Mapping() = default;
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+    ~Mapping() {
+        if (base) ::munmap(base, size);
+    }
+
+    Header* header() const { return static_cast<Header*>(base); }
+    Slot* slots() const {
+        return reinterpret_cast<Slot*>(static_cast<char*>(base) + sizeof(Header));
+    }
+    std::uint64_t capacity() const { return header()->capacity; }
+
+    static std::unique_ptr<Mapping> map(const std::filesystem::path& file, int fd,
+                                        std::size_t size) {
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) return nullptr;
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) return nullptr;
+
+        auto m = std::make_unique<Mapping>();
+        m->base = base;
+        m->size = size;
+        m->file = file;
+        m->inode = st.st_ino;
+        m->device = st.st_dev;
+        return m;
+    }
+
+    // A fully built table at `file`, or nullptr if missing or incompatible.
+    static std::unique_ptr<Mapping> open(const std::filesystem::path& file) {
+        int fd = ::open(file.c_str(), O_RDWR);
+        if (fd < 0) return nullptr;
+
+        std::unique_ptr<Mapping> m;
+        Header h{};
+        struct stat st{};
+        if (::pread(fd, &h, sizeof(h), 0) == sizeof(h) && ::fstat(fd, &st) == 0 &&
+            std::memcmp(h.magic, index_magic, sizeof(index_magic)) == 0 && h.capacity > 0 &&
+            static_cast<std::size_t>(st.st_size) == sizeof(Header) + sizeof(Slot) * h.capacity) {
+            m = map(file, fd, static_cast<std::size_t>(st.st_size));
+        }
+        ::close(fd);
+        return m;
+    }
+
+    // An empty table in a new file; the magic is left unset.
+    static std::unique_ptr<Mapping> create(const std::filesystem::path& file,
+                                           std::uint64_t capacity, std::uint64_t next_seq) {
+        int fd = ::open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return nullptr;
+
+        auto size = sizeof(Header) + sizeof(Slot) * capacity;
+        std::unique_ptr<Mapping> m;
+        if (::ftruncate(fd, static_cast<off_t>(size)) == 0) m = map(file, fd, size);
+        ::close(fd);
+        if (!m) {
+            std::filesystem::remove(file);
+            return nullptr;
+        }
+
+        m->header()->capacity = capacity;
+        m->header()->next_seq = next_seq;
+        return m;
+    }
+
+    std::optional<Entry> find(std::uint64_t fp, std::uint64_t check) const {
+        auto cap = capacity();
+        auto* table = slots();
+        for (std::uint64_t probe = 0; probe < cap; ++probe) {
+            auto& slot = table[(fp + probe) % cap];
+            auto k = load(slot.key);
+            if (k == 0) return std::nullopt;
+            if (k != fp || load(slot.check) != check) continue;
+            return read(slot);
+        }
+        return std::nullopt;
+    }
+
+    // Seqlock read: retries while a writer is mid-update (odd seq) or has
+    // finished one since the first load, so fields never come from two writes
+    static Entry read(const Slot& slot) {
+        for (;;) {
+            auto before = load(slot.seq);
+            if (before & 1) continue;
+            Entry e;
+            e.written = static_cast<std::int64_t>(load_relaxed(slot.written));
+            e.size = load_relaxed(slot.size);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (load_relaxed(slot.seq) != before) continue;
+            e.seq = before / 2;
+            return e;
+        }
+    }
+
+    // Writes `src` (with a plain publish seq) into its slot. A new key's
+    // check and key go in last, so readers never match a half-written slot;
+    // an existing slot is updated under its seqlock.
+    bool place(const Slot& src) {
+        auto cap = capacity();
+        auto* table = slots();
+        for (std::uint64_t probe = 0; probe < cap; ++probe) {
+            auto& slot = table[(src.key + probe) % cap];
+            auto k = load(slot.key);
+            if (k != 0 && (k != src.key || load(slot.check) != src.check)) continue;
+
+            if (k != 0) {
+                store_relaxed(slot.seq, load_relaxed(slot.seq) | 1);
+                __atomic_thread_fence(__ATOMIC_RELEASE);
+            }
+            store_relaxed(slot.written, src.written);
+            store_relaxed(slot.size, src.size);
+            store(slot.seq, src.seq * 2);
+            if (k == 0) {
+                store(slot.check, src.check);
+                store(slot.key, src.key);
+                header()->used++;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    bool over_load() const { return (header()->used + 1) * 4 > capacity() * 3; }
+};
+
+SharedIndex::Guard::Guard(const SharedIndex& index)
+    : index_(index), local_(index.local_mutex_) {
+    if (index_.lock_fd_ >= 0) ::flock(index_.lock_fd_, LOCK_EX);
+    index_.live_locked();
+}
+
+SharedIndex::Guard::~Guard() {
+    if (index_.lock_fd_ >= 0) ::flock(index_.lock_fd_, LOCK_UN);
+}
+
+SharedIndex::SharedIndex(const std::filesystem::path& file, std::uint32_t capacity,
+                         std::function<void(SharedIndex&)> rebuild)
+    : file_(file), initial_capacity_(capacity), rebuild_(std::move(rebuild)) {
+    // The table file is replaced when it grows, so the lock lives elsewhere
+    auto lock_file = file_;
+    lock_file += ".lock";
+    lock_fd_ = ::open(lock_file.c_str(), O_RDWR | O_CREAT, 0644);
+
+    auto guard = lock();
+    if (current_.load(std::memory_order_acquire)) return;
+
+    // New, half-built (a writer died during rebuild) or foreign layout: start over
+    rebuild_locked(initial_capacity_);
+}
+
+SharedIndex::~SharedIndex() {
+    if (building_) std::filesystem::remove(building_->file);
+    if (lock_fd_ >= 0) ::close(lock_fd_);
+}
+
+const SharedIndex::Mapping* SharedIndex::live() const {
+    auto* m = current_.load(std::memory_order_acquire);
+    if (m && load(m->header()->retired)) return remap(m);
+    return m;
+}
+
+// Under the lock, also notices a table replaced by a process that died before
+// marking the old one retired.
+SharedIndex::Mapping* SharedIndex::live_locked() const {
+    auto* m = current_.load(std::memory_order_acquire);
+    if (!m) return remap(nullptr);
+
+    struct stat st{};
+    bool replaced = ::stat(file_.c_str(), &st) == 0 &&
+                    (st.st_ino != m->inode || st.st_dev != m->device);
+    if (replaced || load(m->header()->retired)) return remap(m);
+    return m;
+}
+
+SharedIndex::Mapping* SharedIndex::remap(const Mapping* stale) const {
+    std::lock_guard lock(remap_mutex_);
+    auto* m = current_.load(std::memory_order_acquire);
+    if (m != stale) return m;
+
+    auto fresh = Mapping::open(file_);
+    if (!fresh) return m;
+    m = fresh.get();
+    mappings_.push_back(std::move(fresh));
+    current_.store(m, std::memory_order_release);
+    return m;
+}
+
+std::uint64_t SharedIndex::capacity() const {
+    auto* m = live();
+    return m ? m->capacity() : 0;
+}
+
+bool SharedIndex::authoritative() const {
+    auto* m = live();
+    if (!m) return false;
+    auto* h = m->header();
+    return std::memcmp(h->magic, index_magic, sizeof(index_magic)) == 0 &&
+           load(h->overflowed) == 0 && load(h->retired) == 0;
+}
+
+std::optional<SharedIndex::Entry> SharedIndex::find(std::string_view ns,
+                                                    std::string_view key) const {
+    auto* m = live();
+    if (!m) return std::nullopt;
+    return m->find(record_fingerprint(ns, key), record_check(ns, key));
+}
+
+std::optional<SharedIndex::Entry> SharedIndex::publish(std::string_view ns, std::string_view key,
+                                                       std::int64_t written, std::uint64_t size) {
+    auto* m = building_ ? building_.get() : live_locked();
+    if (!m) return std::nullopt;
+
+    if (m->over_load() || load(m->header()->overflowed)) {
+        if (auto* grown = grow(*m)) m = grown;
+    }
+
+    auto* h = m->header();
+    Slot slot{
+        .key = record_fingerprint(ns, key),
+        .check = record_check(ns, key),
+        .seq = h->next_seq,
+        .written = static_cast<std::uint64_t>(written),
+        .size = size,
+    };
+    if (!m->place(slot)) {
+        store(h->overflowed, 1);
+        return std::nullopt;
+    }
+    h->next_seq++;
+    return Entry{slot.seq, written, size};
+}
+
+void SharedIndex::rebuild() {
+    auto* m = live_locked();
+    rebuild_locked(m ? m->capacity() : initial_capacity_);
+}
+
+// Copies every slot into a table twice the size. An overflowed table is
+// missing records, so it is rebuilt from disk instead.
+SharedIndex::Mapping* SharedIndex::grow(Mapping& full) {
+    auto capacity = full.capacity() * 2;
+    if (&full != building_.get() && load(full.header()->overflowed)) {
+        return rebuild_locked(capacity) ? live_locked() : nullptr;
+    }
+
+    auto next = Mapping::create(temp_path(), capacity, full.header()->next_seq);
+    if (!next) return nullptr;
+
+    auto* table = full.slots();
+    for (std::uint64_t i = 0; i < full.capacity(); ++i) {
+        if (table[i].key == 0) continue;
+        auto slot = table[i];
+        slot.seq /= 2; // writers hold the lock, so no update is in flight
+        next->place(slot);
+    }
+
+    if (&full == building_.get()) {
+        std::filesystem::remove(building_->file);
+        building_ = std::move(next);
+        return building_.get();
+    }
+
+    std::memcpy(next->header()->magic, index_magic, sizeof(index_magic));
+    return install(std::move(next));
+}
+
+bool SharedIndex::rebuild_locked(std::uint64_t capacity) {
+    auto* old = current_.load(std::memory_order_acquire);
+    auto next_seq = old ? old->header()->next_seq : 1;
+    building_ = Mapping::create(temp_path(), capacity, next_seq);
+    if (!building_) return false;
+
+    rebuild_(*this);
+
+    auto next = std::move(building_);
+    std::memcpy(next->header()->magic, index_magic, sizeof(index_magic));
+    return install(std::move(next)) != nullptr;
+}
+
+// Renames a built table over the index file and retires the one it replaces.
+SharedIndex::Mapping* SharedIndex::install(std::unique_ptr<Mapping> next) const {
+    ::msync(next->base, next->size, MS_ASYNC);
+
+    std::error_code ec;
+    std::filesystem::rename(next->file, file_, ec);
+    if (ec) {
+        std::filesystem::remove(next->file, ec);
+        return nullptr;
+    }
+    next->file = file_;
+
+    std::lock_guard lock(remap_mutex_);
+    auto* old = current_.load(std::memory_order_acquire);
+    auto* m = next.get();
+    mappings_.push_back(std::move(next));
+    current_.store(m, std::memory_order_release);
+    if (old) store(old->header()->retired, 1);
+    return m;
+}
+
+std::filesystem::path SharedIndex::temp_path() {
+    auto path = file_;
+    path += ".tmp" + std::to_string(::getpid()) + "." + std::to_string(temp_serial_++);
+    return path;
+}
+
+} // namespace valorant
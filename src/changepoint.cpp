@@ -0,0 +1,155 @@
+#include "valorant/changepoint.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace valorant {
+
+namespace {
+
+// Part of the mean axis on which one candidate segment start is optimal
+struct Piece {
+    double lo;
+    double hi;
+    int start;
+};
+
+} // namespace
+
+std::vector<SeriesSegment> detect_changepoints(std::span<const double> values,
+                                               const ChangepointOptions& options) {
+    int n = static_cast<int>(values.size());
+    if (n == 0) return {};
+
+    // Prefix sums: the cost of [s, t) is its sum of squared deviations
+    std::vector<double> sum(n + 1, 0.0), sum_sq(n + 1, 0.0);
+    for (int i = 0; i < n; ++i) {
+        sum[i + 1] = sum[i] + values[i];
+        sum_sq[i + 1] = sum_sq[i] + values[i] * values[i];
+    }
+    auto cost = [&](int s, int t) {
+        double s1 = sum[t] - sum[s];
+        return std::max(0.0, sum_sq[t] - sum_sq[s] - s1 * s1 / (t - s));
+    };
+    auto whole = [&] { return std::vector<SeriesSegment>{{0, n, sum[n] / n}}; };
+
+    int m = std::max(1, options.min_segment_length);
+    double penalty = options.penalty;
+    if (penalty <= 0.0) {
+        double diff_sq = 0.0;
+        for (int i = 1; i < n; ++i) diff_sq += (values[i] - values[i - 1]) * (values[i] - values[i - 1]);
+        double variance = n > 1 ? diff_sq / (2.0 * (n - 1)) : 0.0;
+        penalty = 2.0 * variance * std::log(static_cast<double>(n));
+    }
+    auto [lo_it, hi_it] = std::ranges::minmax_element(values);
+    if (n < 2 * m || penalty <= 0.0 || *lo_it == *hi_it) return whole();
+
+    // best[t]: minimum penalized cost of values[0, t); last[t]: where the
+    // final segment of that optimum starts
+    std::vector<double> best(n + 1, std::numeric_limits<double>::infinity());
+    std::vector<int> last(n + 1, 0);
+    best[0] = -penalty;
+
+    // Functional pruning. With the segment mean mu left free, start s costs
+    //   best[s] + sum over [s, t) of (y - mu)^2 = g_s(mu) + h_t(mu),
+    //   g_s(mu) = best[s] - sum_sq[s] + 2 sum[s] mu - s mu^2,
+    // where h_t is shared by every start. g_s never changes, so a start that
+    // is nowhere on the lower envelope of the g's (over the data range,
+    // where every segment mean lies) can never be optimal again. Only the
+    // envelope is kept - usually a handful of starts even when nothing
+    // shifts, where PELT's pruning keeps all of them. Starts join once a
+    // full min_segment_length segment fits after them.
+    std::vector<Piece> envelope, next;
+    auto push = [&](double lo, double hi, int start) {
+        if (!(lo < hi)) return;
+        if (!next.empty() && next.back().start == start) next.back().hi = hi;
+        else next.push_back({lo, hi, start});
+    };
+    auto insert = [&](int s) {
+        if (envelope.empty()) {
+            envelope.push_back({*lo_it, *hi_it, s});
+            return;
+        }
+        next.clear();
+        for (auto& piece : envelope) {
+            // g_s - g_old is a concave quadratic (s is the newest start), so
+            // the old start survives only between its two roots
+            int old = piece.start;
+            double a = (best[s] - sum_sq[s]) - (best[old] - sum_sq[old]);
+            double b = 2.0 * (sum[s] - sum[old]);
+            double c = -static_cast<double>(s - old);
+            double disc = b * b - 4.0 * a * c;
+            if (disc <= 0.0) {
+                push(piece.lo, piece.hi, s);
+                continue;
+            }
+            double root = std::sqrt(disc);
+            double r1 = (-b + root) / (2.0 * c);
+            double r2 = (-b - root) / (2.0 * c);
+            if (r1 > r2) std::swap(r1, r2);
+            push(piece.lo, std::min(piece.hi, r1), s);
+            push(std::max(piece.lo, r1), std::min(piece.hi, r2), old);
+            push(std::max(piece.lo, r2), piece.hi, s);
+        }
+        envelope.swap(next);
+    };
+
+    for (int t = m; t <= n; ++t) {
+        int start = t - m;
+        if (start == 0 || start >= m) insert(start);
+
+        // Cheapest start at its own segment mean, held to its piece
+        double best_t = std::numeric_limits<double>::infinity();
+        for (auto& piece : envelope) {
+            int s = piece.start;
+            double mean = (sum[t] - sum[s]) / (t - s);
+            double mu = std::clamp(mean, piece.lo, piece.hi);
+            double v = best[s] + cost(s, t) + (t - s) * (mu - mean) * (mu - mean);
+            if (v < best_t) {
+                best_t = v;
+                last[t] = s;
+            }
+        }
+        best[t] = best_t + penalty;
+    }
+
+    std::vector<SeriesSegment> segments;
+    for (int t = n; t > 0; t = last[t]) {
+        int s = last[t];
+        segments.push_back({s, t, (sum[t] - sum[s]) / (t - s)});
+    }
+    std::ranges::reverse(segments);
+    return segments;
+}
+
+TiltAnalysis detect_tilt(const MatchTable& table, const ChangepointOptions& options) {
+    // A match with no known RR change would read as 0 and fake a shift, so
+    // RR is segmented over the matches that have one
+    std::vector<double> wins(table.size()), rr;
+    std::vector<int> rr_matches;
+    for (size_t i = 0; i < table.size(); ++i) {
+        wins[i] = table.won(i) ? 1.0 : 0.0;
+        if (!table.rr_available(i)) continue;
+        rr.push_back(table.rr_change[i]);
+        rr_matches.push_back(static_cast<int>(i));
+    }
+
+    // Back to match indices: each segment runs up to the next one's first
+    // match, and the last ends just after the last match with RR
+    auto rr_segments = detect_changepoints(rr, options);
+    int rr_count = static_cast<int>(rr_matches.size());
+    for (auto& seg : rr_segments) {
+        seg.end = seg.end < rr_count ? rr_matches[seg.end] : rr_matches.back() + 1;
+        seg.begin = rr_matches[seg.begin];
+    }
+
+    return {
+        .kda = detect_changepoints(table.kda_values, options),
+        .win_rate = detect_changepoints(wins, options),
+        .rr = std::move(rr_segments),
+        .rr_values = std::move(rr),
+        .rr_matches = std::move(rr_matches),
+    };
+}
+
+} // namespace valorant
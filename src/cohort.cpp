@@ -0,0 +1,90 @@
+#include "valorant/cohort.hpp"
+#include "valorant/analytics.hpp"
+#include "valorant/api_client.hpp"
+#include "valorant/arena.hpp"
+#include "valorant/session_detector.hpp"
+#include <algorithm>
+#include <deque>
+#include <future>
+
+namespace valorant {
+
+namespace {
+
+struct PlayerPart {
+    BreakdownAccumulator breakdown;
+    DecayAccumulator decay{true};
+    int sessions = 0;
+};
+
+PlayerPart analyze_player(const std::vector<PlayerMatchSummary>& matches,
+                          const CohortOptions& options) {
+    PlayerPart part;
+    if (matches.empty()) return part;
+
+    Arena arena;
+    auto table = MatchTable::from_matches(matches, arena.resource());
+    auto sessions = detect_sessions(table, options.gap_threshold);
+    part.breakdown.add(table);
+    for (auto& session : sessions) {
+        if (session.game_count() < options.min_session_length) continue;
+        part.decay.add_session(table, session);
+    }
+    part.sessions = static_cast<int>(sessions.size());
+    return part;
+}
+
+template <typename Load>
+CohortReport run_cohort(std::size_t count, Load load, const CohortOptions& options,
+                        ThreadPool& pool) {
+    // A bounded window of players in flight: each merge frees a slot for the
+    // next submission, so finished parts never pile up behind the oldest one
+    std::size_t window = std::max<std::size_t>(1, pool.size() * 2);
+    std::deque<std::future<PlayerPart>> parts;
+    std::size_t next = 0;
+    auto submit = [&] {
+        parts.push_back(pool.submit([&load, &options, i = next++] {
+            return analyze_player(load(i), options);
+        }));
+    };
+    while (next < count && parts.size() < window) submit();
+
+    CohortReport report;
+    BreakdownAccumulator breakdown;
+    DecayAccumulator decay(true);
+    while (!parts.empty()) {
+        auto part = parts.front().get();
+        parts.pop_front();
+        if (next < count) submit();
+        if (part.breakdown.match_count() == 0) continue;
+        report.players++;
+        report.session_count += part.sessions;
+        breakdown.merge(part.breakdown);
+        decay.merge(part.decay);
+    }
+
+    report.match_count = breakdown.match_count();
+    report.hourly = breakdown.hourly();
+    report.heatmap = breakdown.heatmap();
+    report.agents = breakdown.agents();
+    report.maps = breakdown.maps();
+    report.decay = decay.fit(options.weighting);
+    return report;
+}
+
+} // namespace
+
+CohortReport analyze_cohort(const std::vector<std::vector<PlayerMatchSummary>>& players,
+                            const CohortOptions& options, ThreadPool& pool) {
+    return run_cohort(
+        players.size(), [&](std::size_t i) -> const auto& { return players[i]; }, options, pool);
+}
+
+CohortReport analyze_cohort(const Cache& cache, const std::vector<std::string>& puuids,
+                            const CohortOptions& options, ThreadPool& pool) {
+    return run_cohort(
+        puuids.size(), [&](std::size_t i) { return load_cached_matches(cache, puuids[i]); },
+        options, pool);
+}
+
+} // namespace valorant
@@ -0,0 +1,100 @@
+#include "valorant/crc32c.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <nmmintrin.h>
+#define VALORANT_CRC32C_X86 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define VALORANT_CRC32C_ARM 1
+#endif
+
+namespace valorant {
+
+namespace {
+
+constexpr std::uint32_t castagnoli_poly = 0x82F63B78u; // reflected
+
+constexpr std::array<std::uint32_t, 256> make_table() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? (c >> 1) ^ castagnoli_poly : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr auto crc_table = make_table();
+
+std::uint32_t crc32c_portable(const unsigned char* p, std::size_t n, std::uint32_t crc) {
+    while (n--) {
+        crc = crc_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(VALORANT_CRC32C_X86)
+
+__attribute__((target("sse4.2")))
+std::uint32_t crc32c_hw(const unsigned char* p, std::size_t n, std::uint32_t crc) {
+    std::uint64_t c = crc;
+    while (n >= 8) {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        c = _mm_crc32_u64(c, v);
+        p += 8;
+        n -= 8;
+    }
+    auto c32 = static_cast<std::uint32_t>(c);
+    while (n--) c32 = _mm_crc32_u8(c32, *p++);
+    return c32;
+}
+
+bool has_hw_crc() { return __builtin_cpu_supports("sse4.2"); }
+
+#elif defined(VALORANT_CRC32C_ARM)
+
+// Only compiled in when the target baseline guarantees the CRC extension
+// (always true on Apple silicon; pass -march=armv8-a+crc elsewhere).
+std::uint32_t crc32c_hw(const unsigned char* p, std::size_t n, std::uint32_t crc) {
+    while (n >= 8) {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+        p += 8;
+        n -= 8;
+    }
+    while (n--) crc = __crc32cb(crc, *p++);
+    return crc;
+}
+
+bool has_hw_crc() { return true; }
+
+#else
+
+std::uint32_t crc32c_hw(const unsigned char* p, std::size_t n, std::uint32_t crc) {
+    return crc32c_portable(p, n, crc);
+}
+
+bool has_hw_crc() { return false; }
+
+#endif
+
+using CrcImpl = std::uint32_t (*)(const unsigned char*, std::size_t, std::uint32_t);
+
+CrcImpl select_impl() {
+    return has_hw_crc() ? crc32c_hw : crc32c_portable;
+}
+
+} // namespace
+
+std::uint32_t crc32c(const void* data, std::size_t size, std::uint32_t crc) {
+    static const CrcImpl impl = select_impl();
+    return ~impl(static_cast<const unsigned char*>(data), size, ~crc);
+}
+
+} // namespace valorant
@@ -1,9 +1,11 @@
 #include "valorant/display.hpp"
 #include "valorant/analytics.hpp"
+#include "valorant/bootstrap.hpp"
 #include "valorant/session_detector.hpp"
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -34,12 +36,25 @@ std::string f1(double v) {
     return oss.str();
 }
 
+// Bootstrap p-values bottom out near 2 / (replicates + 1), so keep three places
+std::string fpvalue(double p) {
+    if (p < 0.001) return "p < 0.001";
+    std::ostringstream oss;
+    oss << "p = " << std::fixed << std::setprecision(3) << p;
+    return oss.str();
+}
+
 std::string fpct(double v) {
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(1) << (v * 100.0) << "%";
     return oss.str();
 }
 
+// p10-p90 band, e.g. "0.62-2.40"
+std::string frange(const Quantiles& q) {
+    return f2(q.p10) + "-" + f2(q.p90);
+}
+
 std::string frr(int rr) {
     if (rr > 0) return "+" + std::to_string(rr);
     return std::to_string(rr);
@@ -84,14 +99,20 @@ Color streak_color(int s) {
 
 // -- Graph helpers --
 
+// `segments` (indices into `values`) are overlaid as flat lines at their means
 Element make_line_graph(const std::vector<double>& values, const std::string& title,
                         int width = 80, int height = 15,
-                        Color line_color = Color::Cyan) {
+                        Color line_color = Color::Cyan,
+                        const std::vector<SeriesSegment>& segments = {}) {
     if (values.empty()) return text("No data") | dim;
 
     auto [min_it, max_it] = std::ranges::minmax_element(values);
     double vmin = *min_it;
     double vmax = *max_it;
+    for (auto& seg : segments) {
+        vmin = std::min(vmin, seg.mean);
+        vmax = std::max(vmax, seg.mean);
+    }
     double vspan = vmax - vmin;
     if (vspan < 0.001) vspan = 1.0;
 
@@ -110,6 +131,13 @@ Element make_line_graph(const std::vector<double>& values, const std::string& ti
         c.DrawPointLine(x0, y0, x1, y1, line_color);
     }
 
+    for (auto& seg : segments) {
+        int x0 = static_cast<int>(seg.begin * x_step) + 2;
+        int x1 = static_cast<int>((seg.end - 1) * x_step) + 2;
+        int y = canvas_h - 2 - static_cast<int>(((seg.mean - vmin) / vspan) * (canvas_h - 4));
+        c.DrawPointLine(x0, y, x1, y, Color::Yellow);
+    }
+
     return vbox({
         text(title) | bold | color(Color::Cyan),
         hbox({
@@ -215,13 +243,13 @@ Element render_hourly(const std::vector<HourlyPerformance>& data) {
 
     // Table
     std::vector<std::vector<std::string>> rows;
-    rows.push_back({"Hour", "Avg KDA", "Win Rate", "Matches", ""});
+    rows.push_back({"Hour", "Avg KDA", "Median", "Win Rate", "Matches", ""});
     for (auto& h : data) {
         std::string note;
         if (&h == &*best) note = "^ BEST";
         if (&h == &*worst) note = "v WORST";
         rows.push_back({
-            hour12(h.hour), f2(h.avg_kda), fpct(h.win_rate),
+            hour12(h.hour), f2(h.avg_kda), f2(h.kda_quantiles.p50), fpct(h.win_rate),
             std::to_string(h.match_count), note,
         });
     }
@@ -234,7 +262,8 @@ Element render_hourly(const std::vector<HourlyPerformance>& data) {
     for (size_t i = 1; i < rows.size(); ++i) {
         auto& h = data[i - 1];
         table.SelectCell(1, i).Decorate(color(kda_color(h.avg_kda)));
-        table.SelectCell(2, i).Decorate(color(wr_color(h.win_rate)));
+        table.SelectCell(2, i).Decorate(color(kda_color(h.kda_quantiles.p50)));
+        table.SelectCell(3, i).Decorate(color(wr_color(h.win_rate)));
     }
 
     // Bar chart for KDA by hour
@@ -263,6 +292,80 @@ Element render_hourly(const std::vector<HourlyPerformance>& data) {
     });
 }
 
+Element render_heatmap(const WeekHourHeatmap& heatmap) {
+    static constexpr const char* day_names[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+
+    int total = 0;
+    for (auto& cell : heatmap.cells) total += cell.match_count;
+    if (total == 0) return text("No weekday/hour data available.") | dim;
+
+    // One grid per metric: a row per weekday, a two-column cell per hour
+    auto grid = [&](const std::string& title, auto cell_color) {
+        Elements header = {text("     ")};
+        for (int h = 0; h < WeekHourHeatmap::hours; h += 3) {
+            auto label = std::to_string(h);
+            header.push_back(text(label + std::string(6 - label.size(), ' ')) | dim);
+        }
+
+        Elements rows = {text("  " + title) | bold, hbox(header)};
+        for (int d = 0; d < WeekHourHeatmap::days; ++d) {
+            Elements cells = {text(std::string(" ") + day_names[d] + " ") | dim};
+            for (int h = 0; h < WeekHourHeatmap::hours; ++h) {
+                auto& cell = heatmap.at(d, h);
+                cells.push_back(cell.match_count == 0 ? text("· ") | dim
+                                                      : text("██") | color(cell_color(cell)));
+            }
+            rows.push_back(hbox(cells));
+        }
+        return vbox(rows);
+    };
+
+    // Busiest slot, and the worst KDA among slots with a few games
+    const HeatmapCell* busiest = nullptr;
+    const HeatmapCell* worst = nullptr;
+    int busiest_at = 0, worst_at = 0;
+    for (int c = 0; c < static_cast<int>(heatmap.cells.size()); ++c) {
+        auto& cell = heatmap.cells[c];
+        if (!busiest || cell.match_count > busiest->match_count) {
+            busiest = &cell;
+            busiest_at = c;
+        }
+        if (cell.match_count >= 3 && (!worst || cell.avg_kda < worst->avg_kda)) {
+            worst = &cell;
+            worst_at = c;
+        }
+    }
+    auto slot = [&](int c) {
+        return std::string(day_names[c / WeekHourHeatmap::hours]) + " " +
+               hour12(c % WeekHourHeatmap::hours);
+    };
+
+    return vbox({
+        text("Performance by Weekday and Hour") | bold | color(Color::Cyan),
+        separator(),
+        grid("KDA", [](const HeatmapCell& c) { return kda_color(c.avg_kda); }),
+        text(""),
+        grid("Win Rate", [](const HeatmapCell& c) { return wr_color(c.win_rate); }),
+        text(""),
+        grid("Avg RR", [](const HeatmapCell& c) {
+            return rr_color(static_cast<int>(std::lround(c.avg_rr)));
+        }),
+        text(""),
+        hbox({
+            text("  Busiest: ") | dim,
+            text(slot(busiest_at) + " (" + std::to_string(busiest->match_count) + " games, KDA " +
+                 f2(busiest->avg_kda) + ", WR " + fpct(busiest->win_rate) + ")"),
+        }),
+        worst ? hbox({
+            text("  Weakest: ") | dim,
+            text(slot(worst_at) + " (" + std::to_string(worst->match_count) + " games, KDA " +
+                 f2(worst->avg_kda) + ", RR " + f1(worst->avg_rr) + "/game)") |
+                color(Color::Red),
+        }) : text(""),
+        text("  Local time; green/yellow/red use the same thresholds as the other tabs.") | dim,
+    });
+}
+
 Element render_sessions(const std::vector<SessionPerformance>& data) {
     if (data.empty()) return text("No session data available.") | dim;
 
@@ -306,7 +409,57 @@ Element render_sessions(const std::vector<SessionPerformance>& data) {
     });
 }
 
-Element render_rr_sessions(const std::vector<SessionPerformance>& data) {
+// Match-indexed segments moved onto a rolling series' points (point i is
+// match first_index + i) and scaled for display
+std::vector<SeriesSegment> on_series(const std::vector<SeriesSegment>& segments,
+                                     const RollingSeries& series, double scale = 1.0) {
+    std::vector<SeriesSegment> result;
+    int size = static_cast<int>(series.size());
+    for (auto& seg : segments) {
+        int begin = std::max(seg.begin - series.first_index, 0);
+        int end = std::min(seg.end - series.first_index, size);
+        if (begin < end) result.push_back({begin, end, seg.mean * scale});
+    }
+    return result;
+}
+
+// Match-indexed segments moved onto points whose match indices are
+// `point_matches` (ascending), as for the RR series that skips unknown RR
+std::vector<SeriesSegment> on_points(const std::vector<SeriesSegment>& segments,
+                                     const std::vector<int>& point_matches) {
+    std::vector<SeriesSegment> result;
+    for (auto& seg : segments) {
+        int begin = static_cast<int>(std::ranges::lower_bound(point_matches, seg.begin) -
+                                     point_matches.begin());
+        int end = static_cast<int>(std::ranges::lower_bound(point_matches, seg.end) -
+                                   point_matches.begin());
+        if (begin < end) result.push_back({begin, end, seg.mean});
+    }
+    return result;
+}
+
+Element render_shifts(const std::string& title, const std::vector<SeriesSegment>& segments,
+                      const std::function<std::string(double)>& format) {
+    if (segments.size() < 2) {
+        return text("  " + title + ": no significant shifts") | dim;
+    }
+
+    Elements rows = {text("  " + title) | bold};
+    for (size_t i = 0; i < segments.size(); ++i) {
+        auto& seg = segments[i];
+        std::string arrow = i == 0 ? "  " : seg.mean > segments[i - 1].mean ? "^ " : "v ";
+        auto c = i == 0 ? Color::White : seg.mean > segments[i - 1].mean ? Color::Green : Color::Red;
+        rows.push_back(hbox({
+            text("    " + arrow) | color(c),
+            text("matches " + std::to_string(seg.begin + 1) + "-" + std::to_string(seg.end)) |
+                size(WIDTH, EQUAL, 20) | dim,
+            text(format(seg.mean)) | color(c),
+        }));
+    }
+    return vbox(rows);
+}
+
+Element render_rr_sessions(const std::vector<SessionPerformance>& data, const TiltAnalysis& tilt) {
     if (data.empty()) return text("No RR session data available.") | dim;
 
     std::vector<std::vector<std::string>> rows;
@@ -344,6 +497,17 @@ Element render_rr_sessions(const std::vector<SessionPerformance>& data) {
         }));
     }
 
+    Elements per_match;
+    if (!tilt.rr_values.empty()) {
+        per_match = {
+            text(""),
+            make_line_graph(tilt.rr_values, "RR per Match (yellow: shift segments)", 70, 12,
+                            Color::Magenta, on_points(tilt.rr, tilt.rr_matches)),
+            text(""),
+            render_shifts("RR shifts", tilt.rr, [](double v) { return f1(v) + " RR/game"; }),
+        };
+    }
+
     return vbox({
         text("RR Change by Session Length") | bold | color(Color::Cyan),
         separator(),
@@ -351,38 +515,42 @@ Element render_rr_sessions(const std::vector<SessionPerformance>& data) {
         text(""),
         text("  RR per Session") | bold,
         vbox(rr_rows),
+        vbox(per_match),
     });
 }
 
-Element render_rolling_kda(const std::vector<RollingMetric>& data) {
+Element render_rolling_kda(const RollingSeries& data, const std::vector<SeriesSegment>& shifts) {
     if (data.empty()) return text("Not enough matches for rolling KDA.") | dim;
 
-    auto [min_it, max_it] = std::ranges::minmax_element(data, {}, &RollingMetric::value);
+    auto [min_it, max_it] = std::ranges::minmax_element(data);
+    auto min_i = std::distance(data.begin(), min_it);
+    auto max_i = std::distance(data.begin(), max_it);
 
     // Line graph
-    std::vector<double> values;
-    for (auto& m : data) values.push_back(m.value);
-    auto graph = make_line_graph(values, "Rolling KDA Trend", 70, 12, Color::Cyan);
+    std::vector<double> values(data.begin(), data.end());
+    auto graph = make_line_graph(values, "Rolling KDA Trend (yellow: shift segments)", 70, 12,
+                                 Color::Cyan, on_series(shifts, data));
 
     // Sparkline bars
-    double range_min = min_it->value;
-    double range_max = max_it->value;
+    double range_min = *min_it;
+    double range_max = *max_it;
     double span = range_max - range_min;
     if (span < 0.01) span = 1.0;
 
     constexpr int bar_width = 25;
     Elements rows;
-    for (auto& m : data) {
-        auto c = kda_color(m.value);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        double value = data[i];
+        auto c = kda_color(value);
         std::string label;
-        if (&m == &*max_it) label = " ^ peak";
-        if (&m == &*min_it) label = " v low";
+        if (static_cast<std::ptrdiff_t>(i) == max_i) label = " ^ peak";
+        if (static_cast<std::ptrdiff_t>(i) == min_i) label = " v low";
 
         rows.push_back(hbox({
-            text(std::to_string(m.match_index + 1)) | size(WIDTH, EQUAL, 5) | dim,
-            gauge(static_cast<float>((m.value - range_min) / span))
+            text(std::to_string(data.match_index(i) + 1)) | size(WIDTH, EQUAL, 5) | dim,
+            gauge(static_cast<float>((value - range_min) / span))
                 | size(WIDTH, EQUAL, bar_width) | color(c),
-            text(" " + f2(m.value)) | color(c),
+            text(" " + f2(value)) | color(c),
             text(label) | bold,
         }));
     }
@@ -390,6 +558,8 @@ Element render_rolling_kda(const std::vector<RollingMetric>& data) {
     return vbox({
         graph,
         text(""),
+        render_shifts("KDA shifts", shifts, [](double v) { return "avg KDA " + f2(v); }),
+        text(""),
         separator(),
         text("  Match Detail") | bold,
         text("  Range: " + f2(range_min) + " - " + f2(range_max)) | dim,
@@ -397,29 +567,33 @@ Element render_rolling_kda(const std::vector<RollingMetric>& data) {
     });
 }
 
-Element render_rolling_wr(const std::vector<RollingMetric>& data) {
+Element render_rolling_wr(const RollingSeries& data, const std::vector<SeriesSegment>& shifts) {
     if (data.empty()) return text("Not enough matches for rolling win rate.") | dim;
 
-    auto [min_it, max_it] = std::ranges::minmax_element(data, {}, &RollingMetric::value);
+    auto [min_it, max_it] = std::ranges::minmax_element(data);
+    auto min_i = std::distance(data.begin(), min_it);
+    auto max_i = std::distance(data.begin(), max_it);
 
     // Line graph
     std::vector<double> values;
-    for (auto& m : data) values.push_back(m.value * 100.0);
-    auto graph = make_line_graph(values, "Rolling Win Rate Trend (%)", 70, 12, Color::Green);
+    for (double v : data) values.push_back(v * 100.0);
+    auto graph = make_line_graph(values, "Rolling Win Rate Trend (%, yellow: shift segments)",
+                                 70, 12, Color::Green, on_series(shifts, data, 100.0));
 
     constexpr int bar_width = 25;
     Elements rows;
-    for (auto& m : data) {
-        auto c = wr_color(m.value);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        double value = data[i];
+        auto c = wr_color(value);
         std::string label;
-        if (&m == &*max_it) label = " ^ peak";
-        if (&m == &*min_it) label = " v low";
+        if (static_cast<std::ptrdiff_t>(i) == max_i) label = " ^ peak";
+        if (static_cast<std::ptrdiff_t>(i) == min_i) label = " v low";
 
         rows.push_back(hbox({
-            text(std::to_string(m.match_index + 1)) | size(WIDTH, EQUAL, 5) | dim,
-            gauge(static_cast<float>(m.value))
+            text(std::to_string(data.match_index(i) + 1)) | size(WIDTH, EQUAL, 5) | dim,
+            gauge(static_cast<float>(value))
                 | size(WIDTH, EQUAL, bar_width) | color(c),
-            text(" " + fpct(m.value)) | color(c),
+            text(" " + fpct(value)) | color(c),
             text(label) | bold,
         }));
     }
@@ -427,9 +601,11 @@ Element render_rolling_wr(const std::vector<RollingMetric>& data) {
     return vbox({
         graph,
         text(""),
+        render_shifts("Win rate shifts", shifts, [](double v) { return fpct(v) + " wins"; }),
+        text(""),
         separator(),
         text("  Match Detail") | bold,
-        text("  Range: " + fpct(min_it->value) + " - " + fpct(max_it->value)) | dim,
+        text("  Range: " + fpct(*min_it) + " - " + fpct(*max_it)) | dim,
         vbox(rows),
     });
 }
@@ -445,10 +621,20 @@ Element render_decay(const DecayCurveModel& model) {
 
     // Table
     std::vector<std::vector<std::string>> rows;
-    rows.push_back({"Game #", "Avg KDA", "Predicted"});
-    for (auto& [pos, kda] : model.points) {
+    bool spread = !model.point_quantiles.empty();
+    std::vector<std::string> header = {"Game #", "Avg KDA", "Predicted", "Games"};
+    if (spread) header.insert(header.end(), {"Median", "p10-p90"});
+    rows.push_back(std::move(header));
+    for (size_t i = 0; i < model.points.size(); ++i) {
+        auto [pos, kda] = model.points[i];
         double predicted = model.slope * pos + model.intercept;
-        rows.push_back({std::to_string(pos), f2(kda), f2(predicted)});
+        std::vector<std::string> row = {std::to_string(pos), f2(kda), f2(predicted),
+                                        std::to_string(model.sample_counts[i])};
+        if (spread) {
+            row.push_back(f2(model.point_quantiles[i].p50));
+            row.push_back(frange(model.point_quantiles[i]));
+        }
+        rows.push_back(std::move(row));
     }
 
     auto table = Table(rows);
@@ -461,7 +647,13 @@ Element render_decay(const DecayCurveModel& model) {
 
     std::string interpretation;
     Color interp_color;
-    if (model.slope < -0.05) {
+    auto& boot = model.bootstrap;
+    bool significant = boot.replicates == 0 || boot.p_value < 1.0 - boot.confidence;
+    if (model.slope < -0.05 && !significant) {
+        interpretation = "Possible fatigue, but not statistically significant (" +
+                         fpvalue(boot.p_value) + ")";
+        interp_color = Color::Yellow;
+    } else if (model.slope < -0.05) {
         interpretation = "FATIGUE DETECTED - KDA drops " + f2(std::abs(model.slope)) + " per game in session";
         interp_color = Color::Red;
     } else if (model.slope < 0) {
@@ -482,6 +674,15 @@ Element render_decay(const DecayCurveModel& model) {
             text("  Regression: ") | dim,
             text("KDA = " + f2(model.slope) + " * game + " + f2(model.intercept)),
         }),
+        hbox({
+            text("  Slope std. error: ") | dim,
+            text(f2(model.slope_std_error)),
+        }),
+        boot.replicates == 0 ? text("") : hbox({
+            text("  Bootstrap " + std::to_string(static_cast<int>(boot.confidence * 100 + 0.5)) +
+                 "% CI: ") | dim,
+            text("[" + f2(boot.ci_low) + ", " + f2(boot.ci_high) + "]  " + fpvalue(boot.p_value)),
+        }),
         hbox({
             text("  R-squared: ") | dim,
             text(f2(model.r_squared)),
@@ -495,11 +696,13 @@ Element render_agents(const std::vector<AgentPerformance>& data) {
     if (data.empty()) return text("No agent data available.") | dim;
 
     std::vector<std::vector<std::string>> rows;
-    rows.push_back({"Agent", "Games", "KDA", "Win Rate", "DMG/Rnd", "Pick %"});
+    rows.push_back({"Agent", "Games", "KDA", "Median", "p10-p90", "Win Rate",
+                    "DMG/Rnd", "Med DMG", "Pick %"});
     for (auto& a : data) {
         rows.push_back({
-            a.agent, std::to_string(a.games), f2(a.avg_kda),
-            fpct(a.win_rate), f1(a.avg_damage_per_round), fpct(a.pick_rate),
+            a.agent, std::to_string(a.games), f2(a.avg_kda), f2(a.kda_quantiles.p50),
+            frange(a.kda_quantiles), fpct(a.win_rate), f1(a.avg_damage_per_round),
+            f1(a.dpr_quantiles.p50), fpct(a.pick_rate),
         });
     }
 
@@ -511,7 +714,8 @@ Element render_agents(const std::vector<AgentPerformance>& data) {
     for (size_t i = 1; i < rows.size(); ++i) {
         auto& a = data[i - 1];
         table.SelectCell(2, i).Decorate(color(kda_color(a.avg_kda)));
-        table.SelectCell(3, i).Decorate(color(wr_color(a.win_rate)));
+        table.SelectCell(3, i).Decorate(color(kda_color(a.kda_quantiles.p50)));
+        table.SelectCell(5, i).Decorate(color(wr_color(a.win_rate)));
     }
 
     // KDA bar chart
@@ -535,10 +739,10 @@ Element render_maps(const std::vector<MapPerformance>& data) {
     if (data.empty()) return text("No map data available.") | dim;
 
     std::vector<std::vector<std::string>> rows;
-    rows.push_back({"Map", "Games", "KDA", "Win Rate", "Avg Score"});
+    rows.push_back({"Map", "Games", "KDA", "Median", "Win Rate", "Avg Score"});
     for (auto& m : data) {
         rows.push_back({
-            m.map, std::to_string(m.games), f2(m.avg_kda),
+            m.map, std::to_string(m.games), f2(m.avg_kda), f2(m.kda_quantiles.p50),
             fpct(m.win_rate), f1(m.avg_score),
         });
     }
@@ -551,7 +755,8 @@ Element render_maps(const std::vector<MapPerformance>& data) {
     for (size_t i = 1; i < rows.size(); ++i) {
         auto& m = data[i - 1];
         table.SelectCell(2, i).Decorate(color(kda_color(m.avg_kda)));
-        table.SelectCell(3, i).Decorate(color(wr_color(m.win_rate)));
+        table.SelectCell(3, i).Decorate(color(kda_color(m.kda_quantiles.p50)));
+        table.SelectCell(4, i).Decorate(color(wr_color(m.win_rate)));
     }
 
     // Win rate bar chart
@@ -568,22 +773,205 @@ Element render_maps(const std::vector<MapPerformance>& data) {
     });
 }
 
+// Metrics the agent x map tab cycles through with [m]
+constexpr const char* crosstab_metrics[] = {"KDA", "Win Rate", "Games", "DMG/Rnd"};
+constexpr int crosstab_metric_count = 4;
+
+Element render_crosstab(const AgentMapCrossTab& tab, int metric) {
+    if (tab.cells.empty()) return text("No agent/map data available.") | dim;
+
+    auto value = [&](int games, double kda, double wr, double dpr) -> std::string {
+        if (games == 0) return "·";
+        switch (metric) {
+            case 0: return f2(kda);
+            case 1: return fpct(wr);
+            case 2: return std::to_string(games);
+            default: return f1(dpr);
+        }
+    };
+
+    std::vector<std::vector<std::string>> rows;
+    std::vector<std::string> header = {"Agent / Map"};
+    for (auto& m : tab.map_totals) header.push_back(m.map);
+    header.push_back("All");
+    rows.push_back(std::move(header));
+
+    for (size_t a = 0; a < tab.agent_totals.size(); ++a) {
+        auto& total = tab.agent_totals[a];
+        std::vector<std::string> row = {total.agent};
+        for (size_t m = 0; m < tab.map_totals.size(); ++m) {
+            auto& cell = tab.at(a, m);
+            row.push_back(value(cell.games, cell.avg_kda, cell.win_rate, cell.avg_damage_per_round));
+        }
+        row.push_back(value(total.games, total.avg_kda, total.win_rate, total.avg_damage_per_round));
+        rows.push_back(std::move(row));
+    }
+
+    // Map totals track score rather than damage per round
+    std::vector<std::string> all = {"All"};
+    for (auto& m : tab.map_totals) {
+        all.push_back(metric == 3 ? "-" : value(m.games, m.avg_kda, m.win_rate, 0.0));
+    }
+    all.push_back("");
+    rows.push_back(std::move(all));
+
+    auto table = Table(rows);
+    table.SelectRow(0).Decorate(bold);
+    table.SelectRow(0).SeparatorVertical(LIGHT);
+    table.SelectColumn(0).Decorate(bold);
+    table.SelectRow(static_cast<int>(rows.size()) - 1).Decorate(bold);
+    table.SelectAll().Border(LIGHT);
+
+    auto cell_color = [&](const AgentMapCell& cell) -> Color {
+        if (cell.games == 0) return Color::GrayDark;
+        if (metric == 0) return kda_color(cell.avg_kda);
+        if (metric == 1) return wr_color(cell.win_rate);
+        return Color::White;
+    };
+    for (size_t a = 0; a < tab.agent_totals.size(); ++a) {
+        for (size_t m = 0; m < tab.map_totals.size(); ++m) {
+            table.SelectCell(static_cast<int>(m) + 1, static_cast<int>(a) + 1)
+                .Decorate(color(cell_color(tab.at(a, m))));
+        }
+    }
+
+    return vbox({
+        text("Agent x Map") | bold | color(Color::Cyan),
+        separator(),
+        hbox({
+            text("  Showing: ") | dim,
+            text(crosstab_metrics[metric]) | bold,
+            text("   [m] next metric") | dim,
+        }),
+        text(""),
+        table.Render(),
+        text(""),
+        text("  Rows and columns are ordered by games played; · = never played.") | dim,
+    });
+}
+
+Element render_gap_sweep(const std::vector<GapSweepPoint>& sweep, int min_session_length,
+                         int selected, Element slider) {
+    if (sweep.empty()) return text("No matches to sweep.") | dim;
+    selected = std::clamp(selected, 0, static_cast<int>(sweep.size()) - 1);
+    auto& point = sweep[selected];
+
+    std::vector<double> slopes, counts;
+    for (auto& p : sweep) {
+        slopes.push_back(p.decay_slope);
+        counts.push_back(p.session_count);
+    }
+
+    auto stat = [](const std::string& label, const std::string& value) {
+        return hbox({text("  " + label) | dim | size(WIDTH, EQUAL, 24), text(value) | bold});
+    };
+
+    return vbox({
+        text("Session Gap Sweep") | bold | color(Color::Cyan),
+        separator(),
+        hbox({
+            text("  Gap " + std::to_string(sweep.front().gap_minutes) + "m ") | dim,
+            slider | flex,
+            text(" " + std::to_string(sweep.back().gap_minutes) + "m") | dim,
+        }),
+        text(""),
+        stat("Gap threshold:", std::to_string(point.gap_minutes) + " min"),
+        stat("Sessions:", std::to_string(point.session_count)),
+        stat("Avg session length:", f2(point.avg_session_length) + " games"),
+        stat("Sessions of " + std::to_string(min_session_length) + "+ games:",
+             std::to_string(point.qualifying_sessions)),
+        hbox({
+            text("  Decay slope (per game):") | dim | size(WIDTH, EQUAL, 24),
+            text(f2(point.decay_slope) + " KDA/game") | bold |
+                color(point.decay_slope < -0.05 ? Color::Red : Color::Green),
+        }),
+        text(""),
+        make_line_graph(slopes, "Decay Slope by Gap Threshold", 70, 8, Color::Red),
+        text(""),
+        make_line_graph(counts, "Session Count by Gap Threshold", 70, 6),
+        text(""),
+        text("  [Tab] then [←/→] to move the threshold; other tabs keep --gap.") | dim,
+    });
+}
+
+std::string fbytes(std::uint64_t bytes) {
+    if (bytes >= (1u << 20)) return f1(bytes / 1048576.0) + " MB";
+    if (bytes >= (1u << 10)) return f1(bytes / 1024.0) + " KB";
+    return std::to_string(bytes) + " B";
+}
+
+std::string flatency(const LatencyHistogram& h) {
+    if (h.samples == 0) return "-";
+    return f1(h.mean_us()) + " / " + std::to_string(h.percentile_us(0.99)) + " us";
+}
+
+Element render_cache_stats(const CacheStats& stats) {
+    std::vector<std::vector<std::string>> rows;
+    rows.push_back({"Namespace", "Hits", "Misses", "Expired", "Corrupt", "Hit Rate",
+                    "Read", "Written", "Read avg/p99", "Write avg/p99"});
+    for (auto& ns : stats.namespaces) {
+        rows.push_back({
+            ns.name, std::to_string(ns.hits), std::to_string(ns.misses),
+            std::to_string(ns.expired), std::to_string(ns.corrupt), fpct(ns.hit_rate()),
+            fbytes(ns.bytes_read), fbytes(ns.bytes_written),
+            flatency(ns.read_latency), flatency(ns.write_latency),
+        });
+    }
+
+    auto table = Table(rows);
+    table.SelectRow(0).Decorate(bold);
+    table.SelectRow(0).SeparatorVertical(LIGHT);
+    table.SelectAll().Border(LIGHT);
+
+    for (size_t i = 1; i < rows.size(); ++i) {
+        auto& ns = stats.namespaces[i - 1];
+        if (ns.corrupt > 0) table.SelectCell(4, i).Decorate(color(Color::Red));
+        if (ns.lookups() > 0) {
+            table.SelectCell(5, i).Decorate(color(wr_color(ns.hit_rate())));
+        }
+    }
+
+    return vbox({
+        text("Cache Statistics") | bold | color(Color::Cyan),
+        separator(),
+        table.Render(),
+        text(""),
+        text("  Counters cover this process since startup; latency in microseconds.") | dim,
+    });
+}
+
 // -- Report view --
 
-void show_report(ScreenInteractive& screen, const ReportData& data) {
+// Returns true if the user asked for a refresh
+bool show_report(ScreenInteractive& screen, const ReportData& data) {
+    bool refresh = false;
     int selected_tab = 0;
     std::vector<std::string> tab_labels = {
         " Overview      ",
         " Hourly        ",
+        " Heatmap       ",
         " Agents        ",
         " Maps          ",
+        " Agent x Map   ",
         " Sessions      ",
         " RR            ",
         " Rolling KDA   ",
         " Rolling WR    ",
         " Decay         ",
+        " Gap Sweep     ",
+        " Cache         ",
     };
 
+    // Start the slider at the threshold the report was built with
+    int gap_index = 0;
+    for (size_t i = 0; i < data.gap_sweep.size(); ++i) {
+        if (data.gap_sweep[i].gap_minutes <= data.gap_minutes) gap_index = static_cast<int>(i);
+    }
+    int gap_max = std::max(0, static_cast<int>(data.gap_sweep.size()) - 1);
+    auto gap_slider = Slider(std::string(""), &gap_index, 0, gap_max, 1);
+    int crosstab_metric = 0;
+    constexpr int gap_tab = 11;
+
     auto menu_option = MenuOption::Vertical();
     menu_option.entries_option.transform = [](const EntryState& state) {
         auto elem = text(state.label);
@@ -599,17 +987,25 @@ void show_report(ScreenInteractive& screen, const ReportData& data) {
 
     auto menu = Menu(&tab_labels, &selected_tab, menu_option);
 
-    auto content_renderer = Renderer([&] {
+    // The slider only takes focus and arrow keys while its tab is showing
+    auto content = Maybe(gap_slider, [&] { return selected_tab == gap_tab; });
+    auto content_renderer = Renderer(content, [&] {
         switch (selected_tab) {
             case 0: return render_overview(data.overview);
             case 1: return render_hourly(data.hourly);
-            case 2: return render_agents(data.agents);
-            case 3: return render_maps(data.maps);
-            case 4: return render_sessions(data.sessions);
-            case 5: return render_rr_sessions(data.rr_sessions);
-            case 6: return render_rolling_kda(data.rolling_kda);
-            case 7: return render_rolling_wr(data.rolling_wr);
-            case 8: return render_decay(data.decay);
+            case 2: return render_heatmap(data.heatmap);
+            case 3: return render_agents(data.agents);
+            case 4: return render_maps(data.maps);
+            case 5: return render_crosstab(data.crosstab, crosstab_metric);
+            case 6: return render_sessions(data.sessions);
+            case 7: return render_rr_sessions(data.rr_sessions, data.tilt);
+            case 8: return render_rolling_kda(data.rolling_kda, data.tilt.kda);
+            case 9: return render_rolling_wr(data.rolling_wr, data.tilt.win_rate);
+            case 10: return render_decay(data.decay);
+            case gap_tab:
+                return render_gap_sweep(data.gap_sweep, data.min_session_length, gap_index,
+                                        gap_slider->Render());
+            case 12: return render_cache_stats(data.cache_stats);
             default: return text("Unknown tab") | dim;
         }
     });
@@ -634,6 +1030,7 @@ void show_report(ScreenInteractive& screen, const ReportData& data) {
             hbox({
                 text(" [↑/↓] Navigate") | dim,
                 text("  [Tab] Switch pane") | dim,
+                text("  [r] Refresh") | dim,
                 text("  [b] Back") | dim,
                 text("  [q] Quit") | dim,
             }),
@@ -649,10 +1046,169 @@ void show_report(ScreenInteractive& screen, const ReportData& data) {
             screen.Exit();
             return true;
         }
+        if (event == Event::Character('r')) {
+            refresh = true;
+            screen.Exit();
+            return true;
+        }
+        if (event == Event::Character('m') && selected_tab == 5) {
+            crosstab_metric = (crosstab_metric + 1) % crosstab_metric_count;
+            return true;
+        }
         return false;
     });
 
     screen.Loop(with_keys);
+    return refresh;
+}
+
+// One searched player's matches and report state, kept across refreshes so a
+// refresh ingests only the matches played since the previous load. The table
+// grows in place, so it lives on the default heap rather than in an Arena.
+struct LiveReport {
+    LiveReport(const AppConfig& config)
+        : state(config.window, std::chrono::minutes(config.gap_minutes),
+                config.min_session_length) {}
+
+    std::optional<PlayerIdentity> account;
+    MatchTable table;
+    AnalyticsState state;
+};
+
+// Fetches the player's latest matches behind a loading screen and folds the
+// new ones into `live`. Returns nothing on error.
+std::optional<ReportData> load_report(const AppConfig& config, RateLimiter& limiter,
+                                      Cache& cache, const std::string& name,
+                                      const std::string& tag, LiveReport& live) {
+    auto loading_screen = ScreenInteractive::Fullscreen();
+    std::atomic<bool> done{false};
+    std::string load_status = "Looking up " + name + "#" + tag + "...";
+    std::string error_msg;
+    std::optional<ReportData> report;
+
+    std::thread worker([&] {
+        if (!live.account) {
+            auto account = fetch_account(config.client, limiter, name, tag);
+            if (!account) {
+                error_msg = "Account not found: " + account.error().message;
+                done = true;
+                loading_screen.Post(Event::Custom);
+                return;
+            }
+            live.account = *account;
+        }
+
+        load_status = "Fetching matches (up to " +
+                      std::to_string(config.match_count) + ")...";
+        loading_screen.Post(Event::Custom);
+
+        auto matches = fetch_stored_matches(
+            config.client, limiter, cache, config.region, name, tag,
+            live.account->puuid, config.match_count,
+            [&](int current, int total) {
+                load_status = "Fetched " + std::to_string(current) +
+                              "/" + std::to_string(total) + " matches...";
+                loading_screen.Post(Event::Custom);
+            });
+
+        if (!matches || (matches->empty() && live.table.size() == 0)) {
+            error_msg = matches ? "No competitive matches found."
+                                : "Error: " + matches.error().message;
+            done = true;
+            loading_screen.Post(Event::Custom);
+            return;
+        }
+
+        load_status = "Fetching MMR history...";
+        loading_screen.Post(Event::Custom);
+
+        auto mmr_history = fetch_mmr_history(
+            config.client, limiter, cache, config.region, name, tag,
+            live.account->puuid);
+
+        if (mmr_history) {
+            apply_rr_to_summaries(*matches, *mmr_history);
+        }
+
+        load_status = "Computing analytics...";
+        loading_screen.Post(Event::Custom);
+
+        // Matches come back oldest first; anything not newer than the last
+        // ingested match is already in the state
+        auto old_size = live.table.size();
+        auto newest = old_size == 0 ? TimePoint::min()
+                                    : TimePoint(std::chrono::seconds(live.table.start.back()));
+        for (auto& m : *matches) {
+            if (m.game_start > newest) live.table.push_back(m);
+        }
+        live.state.ingest(live.table, old_size);
+
+        // Changepoints, the gap sweep and the bootstrap need the whole table
+        auto& table = live.table;
+        auto sessions = detect_sessions(
+            table, std::chrono::minutes(config.gap_minutes));
+
+        std::vector<int> sweep_gaps;
+        for (int m = 15; m <= 180; m += 5) sweep_gaps.push_back(m);
+        if (std::ranges::find(sweep_gaps, config.gap_minutes) == sweep_gaps.end()) {
+            sweep_gaps.push_back(config.gap_minutes);
+        }
+
+        report = live.state.report(config.decay_weighting);
+        report->player = *live.account;
+        report->tilt = detect_tilt(table);
+        report->gap_sweep = sweep_gap_thresholds(table, sweep_gaps, config.min_session_length);
+        if (config.bootstrap_replicates > 0) {
+            ThreadPool pool;
+            report->decay.bootstrap = bootstrap_decay_slope(
+                table, sessions,
+                {.replicates = config.bootstrap_replicates,
+                 .min_session_length = config.min_session_length,
+                 .weighting = config.decay_weighting},
+                pool);
+        }
+        report->cache_stats = cache.stats();
+
+        done = true;
+        loading_screen.Post(Event::Custom);
+    });
+
+    auto loading_renderer = Renderer([&] {
+        Elements content;
+        content.push_back(text(""));
+        content.push_back(
+            text("  VALORANT Fatigue Analyzer") | bold | color(Color::Cyan));
+        content.push_back(text(""));
+
+        if (!error_msg.empty()) {
+            content.push_back(text("  " + error_msg) | color(Color::Red));
+            content.push_back(text(""));
+            content.push_back(text("  Press any key to go back...") | dim);
+        } else {
+            content.push_back(text("  " + load_status) | bold);
+            content.push_back(text(""));
+            content.push_back(spinner(18, 0) | color(Color::Cyan));
+        }
+
+        return vbox(content) | borderHeavy | color(Color::White) | center;
+    });
+
+    auto loading_events = CatchEvent(loading_renderer, [&](Event event) {
+        if (done) {
+            loading_screen.Exit();
+            return true;
+        }
+        if (event == Event::Escape) {
+            done = true;
+            loading_screen.Exit();
+            return true;
+        }
+        return false;
+    });
+
+    loading_screen.Loop(loading_events);
+    worker.join();
+    return report;
 }
 
 } // namespace
@@ -663,6 +1219,14 @@ void run_app(const AppConfig& config) {
     RateLimiter limiter;
     Cache cache;
 
+    if (!config.bundle_path.empty() && !cache.attach_bundle(config.bundle_path)) {
+        std::cerr << "Ignoring invalid cache bundle: " << config.bundle_path << "\n";
+    }
+
+    if (config.warm_players > 0) {
+        cache.warm_up(cache.recent_players(config.warm_players));
+    }
+
     while (true) {
         auto screen = ScreenInteractive::Fullscreen();
 
@@ -725,122 +1289,28 @@ void run_app(const AppConfig& config) {
         std::string name = search_input.substr(0, hash_pos);
         std::string tag = search_input.substr(hash_pos + 1);
 
-        // Loading screen
-        auto loading_screen = ScreenInteractive::Fullscreen();
-        std::atomic<bool> done{false};
-        std::string load_status = "Looking up " + name + "#" + tag + "...";
-        std::string error_msg;
-        std::optional<ReportData> report;
-
-        std::thread worker([&] {
-            auto account = fetch_account(config.client, limiter, name, tag);
-            if (!account) {
-                error_msg = "Account not found: " + account.error().message;
-                done = true;
-                loading_screen.Post(Event::Custom);
-                return;
-            }
-
-            load_status = "Fetching matches (up to " +
-                          std::to_string(config.match_count) + ")...";
-            loading_screen.Post(Event::Custom);
-
-            auto matches = fetch_stored_matches(
-                config.client, limiter, config.region, name, tag,
-                config.match_count,
-                [&](int current, int total) {
-                    load_status = "Fetched " + std::to_string(current) +
-                                  "/" + std::to_string(total) + " matches...";
-                    loading_screen.Post(Event::Custom);
-                });
-
-            if (!matches || matches->empty()) {
-                error_msg = matches ? "No competitive matches found."
-                                    : "Error: " + matches.error().message;
-                done = true;
-                loading_screen.Post(Event::Custom);
-                return;
-            }
-
-            load_status = "Fetching MMR history...";
-            loading_screen.Post(Event::Custom);
-
-            auto mmr_history = fetch_mmr_history(
-                config.client, limiter, cache, config.region, name, tag,
-                account->puuid);
-
-            if (mmr_history) {
-                apply_rr_to_summaries(*matches, *mmr_history);
-            }
-
-            load_status = "Computing analytics...";
-            loading_screen.Post(Event::Custom);
-
-            auto sessions = detect_sessions(
-                *matches, std::chrono::minutes(config.gap_minutes));
-
-            auto agents = performance_by_agent(*matches);
-            auto maps = performance_by_map(*matches);
-
-            report = ReportData{
-                .player = *account,
-                .match_count = static_cast<int>(matches->size()),
-                .overview = compute_overview(*matches, agents, maps),
-                .hourly = performance_by_hour(*matches),
-                .sessions = performance_by_session(sessions),
-                .rr_sessions = rr_by_session(sessions),
-                .rolling_kda = rolling_kda(*matches, config.window),
-                .rolling_wr = rolling_win_rate(*matches, config.window),
-                .decay = decay_curve(sessions),
-                .agents = std::move(agents),
-                .maps = std::move(maps),
-            };
-
-            done = true;
-            loading_screen.Post(Event::Custom);
-        });
-
-        auto loading_renderer = Renderer([&] {
-            Elements content;
-            content.push_back(text(""));
-            content.push_back(
-                text("  VALORANT Fatigue Analyzer") | bold | color(Color::Cyan));
-            content.push_back(text(""));
-
-            if (!error_msg.empty()) {
-                content.push_back(text("  " + error_msg) | color(Color::Red));
-                content.push_back(text(""));
-                content.push_back(text("  Press any key to go back...") | dim);
-            } else {
-                content.push_back(text("  " + load_status) | bold);
-                content.push_back(text(""));
-                content.push_back(spinner(18, 0) | color(Color::Cyan));
-            }
-
-            return vbox(content) | borderHeavy | color(Color::White) | center;
-        });
-
-        auto loading_events = CatchEvent(loading_renderer, [&](Event event) {
-            if (done) {
-                loading_screen.Exit();
-                return true;
-            }
-            if (event == Event::Escape) {
-                done = true;
-                loading_screen.Exit();
-                return true;
-            }
-            return false;
-        });
-
-        loading_screen.Loop(loading_events);
-        worker.join();
-
-        if (report) {
+        LiveReport live(config);
+        while (auto report = load_report(config, limiter, cache, name, tag, live)) {
             auto report_screen = ScreenInteractive::Fullscreen();
-            show_report(report_screen, *report);
+            if (!show_report(report_screen, *report)) break;
         }
     }
+
+    if (config.dump_cache_stats) print_cache_stats(std::cerr, cache.stats());
+}
+
+void print_cache_stats(std::ostream& out, const CacheStats& stats) {
+    out << "Cache statistics\n";
+    for (auto& ns : stats.namespaces) {
+        out << "  " << std::left << std::setw(12) << ns.name
+            << " hits " << ns.hits << ", misses " << ns.misses
+            << " (" << ns.expired << " expired, " << ns.corrupt << " corrupt)"
+            << ", hit rate " << fpct(ns.hit_rate())
+            << ", read " << fbytes(ns.bytes_read)
+            << ", written " << fbytes(ns.bytes_written) << " in " << ns.writes << " writes"
+            << ", read avg/p99 " << flatency(ns.read_latency)
+            << ", write avg/p99 " << flatency(ns.write_latency) << "\n";
+    }
 }
 
 } // namespace valorant
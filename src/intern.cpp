@@ -0,0 +1,54 @@
+#include "valorant/intern.hpp"
+#include <limits>
+#include <mutex>
+
+namespace valorant {
+
+InternTable::InternTable() {
+    names_.emplace_back();
+    ids_.emplace("", 0);
+}
+
+NameId InternTable::intern(std::string_view name) {
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = ids_.find(name); it != ids_.end()) return it->second;
+    }
+
+    std::unique_lock lock(mutex_);
+    if (auto it = ids_.find(name); it != ids_.end()) return it->second;
+
+    // Out of ids: a wrapped id would alias a real name, so fall back to 0
+    if (names_.size() > std::numeric_limits<NameId>::max()) return 0;
+    auto id = static_cast<NameId>(names_.size());
+    names_.emplace_back(name);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+const std::string& InternTable::name(NameId id) const {
+    std::shared_lock lock(mutex_);
+    return id < names_.size() ? names_[id] : names_[0];
+}
+
+std::size_t InternTable::size() const {
+    std::shared_lock lock(mutex_);
+    return names_.size();
+}
+
+InternTable& map_names() {
+    static InternTable table;
+    return table;
+}
+
+InternTable& mode_names() {
+    static InternTable table;
+    return table;
+}
+
+InternTable& agent_names() {
+    static InternTable table;
+    return table;
+}
+
+} // namespace valorant
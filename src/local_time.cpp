@@ -0,0 +1,43 @@
+#include "valorant/local_time.hpp"
+#include <ctime>
+
+namespace valorant {
+
+namespace {
+
+constexpr std::int64_t secs_per_day = 86400;
+
+std::int64_t floor_div(std::int64_t a, std::int64_t b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+std::int32_t utc_offset(std::int64_t unix_secs) {
+    auto tt = static_cast<std::time_t>(unix_secs);
+    std::tm tm{};
+    if (!localtime_r(&tt, &tm)) return 0;
+    return static_cast<std::int32_t>(tm.tm_gmtoff);
+}
+
+} // namespace
+
+LocalTime LocalTimeCache::at(std::int64_t unix_secs) {
+    auto day = floor_div(unix_secs, secs_per_day);
+
+    auto [it, inserted] = day_offsets_.try_emplace(day, 0);
+    if (inserted) {
+        auto first = utc_offset(day * secs_per_day);
+        auto last = utc_offset(day * secs_per_day + secs_per_day - 1);
+        it->second = first == last ? first : transition_day;
+    }
+
+    std::int32_t offset = it->second != transition_day ? it->second : utc_offset(unix_secs);
+
+    auto local = unix_secs + offset;
+    auto local_day = floor_div(local, secs_per_day);
+    return {
+        .hour = static_cast<std::uint8_t>((local - local_day * secs_per_day) / 3600),
+        .weekday = static_cast<std::uint8_t>(((local_day + 4) % 7 + 7) % 7), // 1970-01-01 was a Thursday
+    };
+}
+
+} // namespace valorant
@@ -1,26 +1,61 @@
+#include "valorant/cache.hpp"
+#include "valorant/cohort.hpp"
 #include "valorant/display.hpp"
 #include "valorant/env.hpp"
+#include <charconv>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <string>
 
 namespace {
 
-std::optional<valorant::AppConfig> parse_args(int argc, char* argv[]) {
+// Options start at argv[first]; commands such as `cohort <arg>` skip their operands
+std::optional<valorant::AppConfig> parse_args(int argc, char* argv[], int first = 1) {
     valorant::AppConfig config;
 
-    for (int i = 1; i < argc; i += 2) {
+    for (int i = first; i < argc; ++i) {
         std::string flag = argv[i];
+        if (flag == "--cache-stats") {
+            config.dump_cache_stats = true;
+            continue;
+        }
+
         if (i + 1 >= argc) {
             std::cerr << "Missing value for " << flag << "\n";
             return std::nullopt;
         }
-        std::string val = argv[i + 1];
+        std::string val = argv[++i];
 
         if (flag == "--region") config.region = val;
-        else if (flag == "--matches") config.match_count = std::stoi(val);
+        else if (flag == "--matches") {
+            config.match_count = std::stoi(val);
+            if (config.match_count <= 0) {
+                std::cerr << "--matches must be positive\n";
+                return std::nullopt;
+            }
+        }
         else if (flag == "--window") config.window = std::stoi(val);
         else if (flag == "--gap") config.gap_minutes = std::stoi(val);
+        else if (flag == "--min-session") {
+            config.min_session_length = std::stoi(val);
+            if (config.min_session_length <= 0) {
+                std::cerr << "--min-session must be positive\n";
+                return std::nullopt;
+            }
+        }
         else if (flag == "--api-key") config.client.api_key = val;
+        else if (flag == "--warm") config.warm_players = std::stoi(val);
+        else if (flag == "--bundle") config.bundle_path = val;
+        else if (flag == "--bootstrap") config.bootstrap_replicates = std::stoi(val);
+        else if (flag == "--decay-weights") {
+            if (val != "positions" && val != "games") {
+                std::cerr << "Invalid value for --decay-weights: " << val << "\n";
+                return std::nullopt;
+            }
+            config.decay_weighting = val == "games" ? valorant::DecayWeighting::Samples
+                                                    : valorant::DecayWeighting::PositionMeans;
+        }
         else {
             std::cerr << "Unknown option: " << flag << "\n";
             return std::nullopt;
@@ -36,23 +71,156 @@ std::optional<valorant::AppConfig> parse_args(int argc, char* argv[]) {
     return config;
 }
 
+int run_verify() {
+    valorant::Cache cache;
+    auto report = cache.verify();
+
+    std::cout << "Scanned " << report.scanned << " cached records: "
+              << report.ok << " ok, " << report.legacy << " legacy, "
+              << report.corrupt << " corrupt\n";
+    for (auto& [ns, count] : report.corrupt_by_namespace) {
+        if (count > 0) std::cout << "  " << ns << ": " << count << " corrupt\n";
+    }
+    for (auto& path : report.corrupt_files) {
+        std::cout << "  corrupt: " << path.string() << "\n";
+    }
+    return report.corrupt > 0 ? 1 : 0;
+}
+
+int run_export(const std::string& file) {
+    valorant::Cache cache;
+    auto count = cache.export_bundle(file);
+    if (!count) {
+        std::cerr << "Failed to write bundle " << file << "\n";
+        return 1;
+    }
+    std::cout << "Exported " << *count << " cached records to " << file << "\n";
+    return 0;
+}
+
+int run_import(const std::string& file) {
+    valorant::Cache cache;
+    auto count = cache.import_bundle(file);
+    if (!count) {
+        std::cerr << "Not a valid cache bundle: " << file << "\n";
+        return 1;
+    }
+    std::cout << "Imported " << *count << " records from " << file << "\n";
+    return 0;
+}
+
+// Players for a cohort: the n most recently viewed, or one puuid per line
+std::vector<std::string> cohort_players(const valorant::Cache& cache, const std::string& arg) {
+    std::size_t n = 0;
+    auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), n);
+    if (ec == std::errc{} && end == arg.data() + arg.size()) return cache.recent_players(n);
+
+    std::vector<std::string> puuids;
+    std::ifstream in(arg);
+    for (std::string line; std::getline(in, line);) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty() && line[0] != '#') puuids.push_back(line);
+    }
+    return puuids;
+}
+
+int run_cohort(const std::string& arg, const valorant::AppConfig& config) {
+    valorant::Cache cache;
+    auto puuids = cohort_players(cache, arg);
+    if (puuids.empty()) {
+        std::cerr << "No players for cohort: " << arg << "\n";
+        return 1;
+    }
+
+    valorant::CohortOptions options{
+        .gap_threshold = std::chrono::minutes(config.gap_minutes),
+        .min_session_length = config.min_session_length,
+        .weighting = config.decay_weighting,
+    };
+    valorant::ThreadPool pool;
+    auto report = valorant::analyze_cohort(cache, puuids, options, pool);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Cohort: " << report.players << " of " << puuids.size() << " players, "
+              << report.match_count << " matches, " << report.session_count << " sessions\n";
+
+    auto& decay = report.decay;
+    std::cout << "\nKDA by game in session\n"
+              << "  Game   Avg KDA   Median    Games\n";
+    for (size_t i = 0; i < decay.points.size(); ++i) {
+        std::cout << "  " << std::setw(4) << decay.points[i].first
+                  << std::setw(10) << decay.points[i].second
+                  << std::setw(9) << decay.point_quantiles[i].p50
+                  << std::setw(9) << decay.sample_counts[i] << "\n";
+    }
+    std::cout << "  Slope " << decay.slope << " KDA/game (std. error "
+              << decay.slope_std_error << "), R-squared " << decay.r_squared << "\n";
+
+    std::cout << "\nBy hour\n  Hour   Avg KDA   Median  Win Rate  Matches\n";
+    for (auto& h : report.hourly) {
+        std::cout << "  " << std::setw(4) << h.hour << std::setw(10) << h.avg_kda
+                  << std::setw(9) << h.kda_quantiles.p50
+                  << std::setw(9) << h.win_rate * 100 << "%"
+                  << std::setw(9) << h.match_count << "\n";
+    }
+
+    std::cout << "\nBy agent\n";
+    for (auto& a : report.agents) {
+        std::cout << "  " << std::left << std::setw(12) << a.agent << std::right
+                  << std::setw(7) << a.games << " games  KDA " << a.avg_kda
+                  << " (median " << a.kda_quantiles.p50 << ")  WR "
+                  << a.win_rate * 100 << "%\n";
+    }
+
+    std::cout << "\nBy map\n";
+    for (auto& m : report.maps) {
+        std::cout << "  " << std::left << std::setw(12) << m.map << std::right
+                  << std::setw(7) << m.games << " games  KDA " << m.avg_kda
+                  << " (median " << m.kda_quantiles.p50 << ")  WR "
+                  << m.win_rate * 100 << "%\n";
+    }
+    return 0;
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
     valorant::load_env();
 
-    auto config = parse_args(argc, argv);
+    bool cohort = false;
+    if (argc >= 2) {
+        std::string command = argv[1];
+        if (command == "verify") return run_verify();
+        cohort = command == "cohort" && argc >= 3;
+        if ((command == "export" || command == "import") && argc >= 3) {
+            return command == "export" ? run_export(argv[2]) : run_import(argv[2]);
+        }
+    }
+
+    auto config = parse_args(argc, argv, cohort ? 3 : 1);
     if (!config) {
         std::cerr << R"(Usage: valorant-fatigue [options]
+       valorant-fatigue verify
+       valorant-fatigue export <bundle>
+       valorant-fatigue import <bundle>
+       valorant-fatigue cohort <n | puuid-file> [--gap <minutes>] [--min-session <n>]
+                               [--decay-weights <positions|games>]
   --region <na|eu|ap|kr>    Region (default: na)
   --matches <n>             Number of matches (default: 200)
   --window <n>              Rolling window size (default: 20)
   --gap <minutes>           Session gap threshold (default: 45)
+  --min-session <n>         Shortest session counted in the decay fit (default: 3)
   --api-key <key>           API key (or set VALORANT_API_KEY in .env)
+  --warm <n>                Preload the n most recently viewed players' cached records
+  --cache-stats             Print cache hit/miss/latency stats on exit
+  --bundle <file>           Serve cache misses from an exported bundle
+  --bootstrap <n>           Bootstrap replicates for the decay slope CI (default: 2000, 0 = off)
+  --decay-weights <positions|games>
+                            Fit fatigue decay over position averages or every game
 )";
         return 1;
     }
 
+    if (cohort) return run_cohort(argv[2], *config);
     valorant::run_app(*config);
     return 0;
 }
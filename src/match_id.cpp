@@ -0,0 +1,73 @@
+#include "valorant/match_id.hpp"
+
+namespace valorant {
+
+namespace {
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// 8-4-4-4-12 hex digits; fills `id` and returns true on success.
+bool parse_uuid(std::string_view text, MatchId& id) {
+    if (text.size() != 36) return false;
+
+    std::uint64_t words[2] = {0, 0};
+    int digits = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (i == 8 || i == 13 || i == 18 || i == 23) {
+            if (text[i] != '-') return false;
+            continue;
+        }
+        int v = hex_value(text[i]);
+        if (v < 0) return false;
+        auto& word = words[digits / 16];
+        word = (word << 4) | static_cast<std::uint64_t>(v);
+        ++digits;
+    }
+
+    id = {.hi = words[0], .lo = words[1]};
+    return true;
+}
+
+std::uint64_t fnv1a(std::string_view text, std::uint64_t h) {
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+} // namespace
+
+MatchId MatchId::parse(std::string_view text) {
+    if (text.empty()) return {};
+
+    MatchId id;
+    if (parse_uuid(text, id)) return id;
+
+    // Not a UUID: two independently seeded hashes fill the 128 bits
+    id = {.hi = fnv1a(text, 0xcbf29ce484222325ull),
+          .lo = fnv1a(text, 0x84222325cbf29ce4ull)};
+    if (id.empty()) id.lo = 1;
+    return id;
+}
+
+std::string MatchId::to_string() const {
+    if (empty()) return {};
+
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(36);
+    for (int i = 0; i < 32; ++i) {
+        if (i == 8 || i == 12 || i == 16 || i == 20) out.push_back('-');
+        auto word = i < 16 ? hi : lo;
+        out.push_back(digits[(word >> (60 - 4 * (i % 16))) & 0xf]);
+    }
+    return out;
+}
+
+} // namespace valorant
@@ -0,0 +1,137 @@
+#include "valorant/match_kernels.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define VALORANT_KERNELS_AVX2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define VALORANT_KERNELS_NEON 1
+#endif
+
+namespace valorant {
+
+namespace {
+
+void kda_scalar(const std::int32_t* kills, const std::int32_t* deaths,
+                const std::int32_t* assists, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<double>(kills[i] + assists[i]) / std::max(deaths[i], 1);
+    }
+}
+
+void dpr_scalar(const std::int32_t* damage, const std::int32_t* rounds,
+                double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        double q = static_cast<double>(damage[i]) / std::max(rounds[i], 1);
+        out[i] = rounds[i] != 0 ? q : 0.0; // select, not a branch
+    }
+}
+
+#if defined(VALORANT_KERNELS_AVX2)
+
+__m128i load4(const std::int32_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+__attribute__((target("avx2")))
+void kda_simd(const std::int32_t* kills, const std::int32_t* deaths,
+              const std::int32_t* assists, double* out, std::size_t n) {
+    const __m128i one = _mm_set1_epi32(1);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i num = _mm_add_epi32(load4(kills + i), load4(assists + i));
+        __m128i den = _mm_max_epi32(load4(deaths + i), one);
+        _mm256_storeu_pd(out + i, _mm256_div_pd(_mm256_cvtepi32_pd(num),
+                                                _mm256_cvtepi32_pd(den)));
+    }
+    kda_scalar(kills + i, deaths + i, assists + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void dpr_simd(const std::int32_t* damage, const std::int32_t* rounds,
+              double* out, std::size_t n) {
+    const __m128i one = _mm_set1_epi32(1);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i r = load4(rounds + i);
+        __m256d q = _mm256_div_pd(_mm256_cvtepi32_pd(load4(damage + i)),
+                                  _mm256_cvtepi32_pd(_mm_max_epi32(r, one)));
+        // All-ones lanes where rounds == 0, widened to 64 bits
+        __m256d zero = _mm256_castsi256_pd(
+            _mm256_cvtepi32_epi64(_mm_cmpeq_epi32(r, _mm_setzero_si128())));
+        _mm256_storeu_pd(out + i, _mm256_andnot_pd(zero, q));
+    }
+    dpr_scalar(damage + i, rounds + i, out + i, n - i);
+}
+
+bool has_simd() { return __builtin_cpu_supports("avx2"); }
+
+#elif defined(VALORANT_KERNELS_NEON)
+
+float64x2_t to_f64(int32x2_t v) { return vcvtq_f64_s64(vmovl_s32(v)); }
+
+void kda_simd(const std::int32_t* kills, const std::int32_t* deaths,
+              const std::int32_t* assists, double* out, std::size_t n) {
+    const int32x2_t one = vdup_n_s32(1);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        int32x2_t num = vadd_s32(vld1_s32(kills + i), vld1_s32(assists + i));
+        int32x2_t den = vmax_s32(vld1_s32(deaths + i), one);
+        vst1q_f64(out + i, vdivq_f64(to_f64(num), to_f64(den)));
+    }
+    kda_scalar(kills + i, deaths + i, assists + i, out + i, n - i);
+}
+
+void dpr_simd(const std::int32_t* damage, const std::int32_t* rounds,
+              double* out, std::size_t n) {
+    const int32x2_t one = vdup_n_s32(1);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        int32x2_t r = vld1_s32(rounds + i);
+        float64x2_t q = vdivq_f64(to_f64(vld1_s32(damage + i)), to_f64(vmax_s32(r, one)));
+        // Sign-extend the 32-bit compare result to an all-ones 64-bit mask
+        uint64x2_t zero = vreinterpretq_u64_s64(
+            vmovl_s32(vreinterpret_s32_u32(vceq_s32(r, vdup_n_s32(0)))));
+        vst1q_f64(out + i, vreinterpretq_f64_u64(vbicq_u64(vreinterpretq_u64_f64(q), zero)));
+    }
+    dpr_scalar(damage + i, rounds + i, out + i, n - i);
+}
+
+bool has_simd() { return true; } // NEON is part of the AArch64 baseline
+
+#else
+
+void kda_simd(const std::int32_t* kills, const std::int32_t* deaths,
+              const std::int32_t* assists, double* out, std::size_t n) {
+    kda_scalar(kills, deaths, assists, out, n);
+}
+
+void dpr_simd(const std::int32_t* damage, const std::int32_t* rounds,
+              double* out, std::size_t n) {
+    dpr_scalar(damage, rounds, out, n);
+}
+
+bool has_simd() { return false; }
+
+#endif
+
+using KdaImpl = void (*)(const std::int32_t*, const std::int32_t*, const std::int32_t*,
+                         double*, std::size_t);
+using DprImpl = void (*)(const std::int32_t*, const std::int32_t*, double*, std::size_t);
+
+} // namespace
+
+void kda_column(const std::int32_t* kills, const std::int32_t* deaths,
+                const std::int32_t* assists, double* out, std::size_t n) {
+    static const KdaImpl impl = has_simd() ? kda_simd : kda_scalar;
+    impl(kills, deaths, assists, out, n);
+}
+
+void dpr_column(const std::int32_t* damage, const std::int32_t* rounds,
+                double* out, std::size_t n) {
+    static const DprImpl impl = has_simd() ? dpr_simd : dpr_scalar;
+    impl(damage, rounds, out, n);
+}
+
+} // namespace valorant
@@ -0,0 +1,119 @@
+#include "valorant/match_table.hpp"
+#include "valorant/match_kernels.hpp"
+
+namespace valorant {
+
+namespace {
+
+void push_bit(std::pmr::vector<std::uint64_t>& bits, std::size_t i, bool value) {
+    if ((i & 63) == 0) bits.push_back(0);
+    if (value) bits.back() |= std::uint64_t{1} << (i & 63);
+}
+
+// Fills the derived columns for rows [from, size()).
+void derive_columns(MatchTable& table, std::size_t from) {
+    auto n = table.size();
+    table.kda_values.resize(n);
+    table.dpr_values.resize(n);
+    kda_column(table.kills.data() + from, table.deaths.data() + from,
+               table.assists.data() + from, table.kda_values.data() + from, n - from);
+    dpr_column(table.damage.data() + from, table.rounds.data() + from,
+               table.dpr_values.data() + from, n - from);
+}
+
+void append_row(MatchTable& table, const PlayerMatchSummary& m, LocalTimeCache& local_time) {
+    auto i = table.size();
+    auto start_secs = std::chrono::duration_cast<std::chrono::seconds>(
+        m.game_start.time_since_epoch()).count();
+    auto local = local_time.at(start_secs);
+
+    table.match_id.push_back(m.match_id);
+    table.start.push_back(start_secs);
+    table.local_hour.push_back(local.hour);
+    table.local_weekday.push_back(local.weekday);
+    table.game_length_secs.push_back(m.game_length_secs);
+    table.kills.push_back(m.kills);
+    table.deaths.push_back(m.deaths);
+    table.assists.push_back(m.assists);
+    table.score.push_back(m.score);
+    table.damage.push_back(m.damage_made);
+    table.rounds.push_back(m.rounds_played);
+    table.rr_change.push_back(m.rr_change);
+    push_bit(table.won_bits, i, m.won);
+    push_bit(table.rr_available_bits, i, m.rr_available);
+    table.map_id.push_back(m.map_id);
+    table.mode_id.push_back(m.mode_id);
+    table.agent_id.push_back(m.agent_id);
+}
+
+} // namespace
+
+MatchTable::MatchTable(std::pmr::memory_resource* mr)
+    : match_id(mr), start(mr), local_hour(mr), local_weekday(mr), game_length_secs(mr), kills(mr), deaths(mr),
+      assists(mr), score(mr), damage(mr), rounds(mr), rr_change(mr),
+      won_bits(mr), rr_available_bits(mr), map_id(mr), mode_id(mr), agent_id(mr),
+      kda_values(mr), dpr_values(mr) {}
+
+MatchTable MatchTable::from_matches(const std::vector<PlayerMatchSummary>& matches,
+                                    std::pmr::memory_resource* mr) {
+    MatchTable table(mr);
+    table.reserve(matches.size());
+    LocalTimeCache local_time;
+    for (auto& m : matches) append_row(table, m, local_time);
+    derive_columns(table, 0);
+    return table;
+}
+
+void MatchTable::reserve(std::size_t n) {
+    match_id.reserve(n);
+    start.reserve(n);
+    local_hour.reserve(n);
+    local_weekday.reserve(n);
+    game_length_secs.reserve(n);
+    kills.reserve(n);
+    deaths.reserve(n);
+    assists.reserve(n);
+    score.reserve(n);
+    damage.reserve(n);
+    rounds.reserve(n);
+    rr_change.reserve(n);
+    won_bits.reserve((n + 63) / 64);
+    rr_available_bits.reserve((n + 63) / 64);
+    map_id.reserve(n);
+    mode_id.reserve(n);
+    agent_id.reserve(n);
+    kda_values.reserve(n);
+    dpr_values.reserve(n);
+}
+
+void MatchTable::push_back(const PlayerMatchSummary& m) {
+    LocalTimeCache local_time;
+    push_back(m, local_time);
+}
+
+void MatchTable::push_back(const PlayerMatchSummary& m, LocalTimeCache& local_time) {
+    append_row(*this, m, local_time);
+    derive_columns(*this, size() - 1);
+}
+
+PlayerMatchSummary MatchTable::row(std::size_t i) const {
+    PlayerMatchSummary m;
+    m.match_id = match_id[i];
+    m.map_id = map_id[i];
+    m.mode_id = mode_id[i];
+    m.agent_id = agent_id[i];
+    m.game_start = TimePoint(std::chrono::seconds(start[i]));
+    m.game_length_secs = game_length_secs[i];
+    m.kills = kills[i];
+    m.deaths = deaths[i];
+    m.assists = assists[i];
+    m.score = score[i];
+    m.damage_made = damage[i];
+    m.rounds_played = rounds[i];
+    m.won = won(i);
+    m.rr_change = rr_change[i];
+    m.rr_available = rr_available(i);
+    return m;
+}
+
+} // namespace valorant
@@ -0,0 +1,117 @@
+#include "valorant/quantile_sketch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace valorant {
+
+namespace {
+
+// k1 scale function: centroid size limits shrink toward q = 0 and q = 1
+double k_of_q(double q, double compression) {
+    return compression / (2.0 * std::numbers::pi) * std::asin(2.0 * q - 1.0);
+}
+
+double q_of_k(double k, double compression) {
+    return (std::sin(k * 2.0 * std::numbers::pi / compression) + 1.0) / 2.0;
+}
+
+} // namespace
+
+QuantileSketch::QuantileSketch(double compression) : compression_(compression) {}
+
+void QuantileSketch::add(double value) {
+    if (empty()) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    buffer_.push_back({value, 1.0});
+    buffered_ += 1.0;
+    if (buffer_.size() >= static_cast<std::size_t>(compression_ * 5)) flush();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.empty()) return;
+    if (empty()) {
+        *this = other;
+        return;
+    }
+
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    buffer_.insert(buffer_.end(), other.centroids_.begin(), other.centroids_.end());
+    buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+    buffered_ += other.count();
+    flush();
+}
+
+void QuantileSketch::flush() {
+    if (buffer_.empty()) return;
+    auto points = std::move(centroids_);
+    points.insert(points.end(), buffer_.begin(), buffer_.end());
+    centroids_ = compressed(std::move(points));
+    total_ += buffered_;
+    buffer_.clear();
+    buffered_ = 0.0;
+}
+
+std::vector<QuantileSketch::Centroid> QuantileSketch::compressed(std::vector<Centroid> points) const {
+    // Stable, so equal means keep a deterministic order
+    std::ranges::stable_sort(points, {}, &Centroid::mean);
+
+    double total = 0.0;
+    for (auto& c : points) total += c.weight;
+
+    std::vector<Centroid> result;
+    double weight_before = 0.0; // weight of every centroid before result.back()
+    double limit = total * q_of_k(k_of_q(0.0, compression_) + 1.0, compression_);
+    for (auto& c : points) {
+        if (!result.empty() && weight_before + result.back().weight + c.weight <= limit) {
+            auto& cur = result.back();
+            cur.weight += c.weight;
+            cur.mean += (c.mean - cur.mean) * c.weight / cur.weight;
+            continue;
+        }
+        if (!result.empty()) {
+            weight_before += result.back().weight;
+            limit = total * q_of_k(k_of_q(weight_before / total, compression_) + 1.0, compression_);
+        }
+        result.push_back(c);
+    }
+    return result;
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (empty()) return 0.0;
+    q = std::clamp(q, 0.0, 1.0);
+
+    auto points = buffer_.empty() ? centroids_ : [&] {
+        auto all = centroids_;
+        all.insert(all.end(), buffer_.begin(), buffer_.end());
+        return compressed(std::move(all));
+    }();
+    if (points.size() == 1) return points.front().mean;
+
+    // Each centroid's mean sits at the middle of its weight; interpolate
+    // between neighbouring centres, and toward min/max beyond the ends
+    double target = q * count();
+    double center = points.front().weight / 2.0;
+    if (target < center) {
+        return min_ + (points.front().mean - min_) * (target / center);
+    }
+    for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+        double next = center + (points[i].weight + points[i + 1].weight) / 2.0;
+        if (target <= next) {
+            double t = (target - center) / (next - center);
+            return points[i].mean + (points[i + 1].mean - points[i].mean) * t;
+        }
+        center = next;
+    }
+    double tail = count() - center;
+    if (tail <= 0.0) return points.back().mean;
+    return points.back().mean + (max_ - points.back().mean) * ((target - center) / tail);
+}
+
+} // namespace valorant
@@ -2,33 +2,48 @@
 
 namespace valorant {
 
-std::vector<Session> detect_sessions(
-    const std::vector<PlayerMatchSummary>& matches,
-    std::chrono::minutes gap_threshold) {
+namespace {
 
-    if (matches.empty()) return {};
+template <typename GapExceeded>
+std::vector<Session> split_sessions(int n, GapExceeded gap_exceeded) {
+    if (n == 0) return {};
 
     std::vector<Session> sessions;
-    Session current;
-    current.index = 0;
-    current.matches.push_back(matches[0]);
-
-    for (size_t i = 1; i < matches.size(); ++i) {
-        auto& prev = current.matches.back();
-        auto prev_end = prev.game_start + std::chrono::seconds(prev.game_length_secs);
-        auto gap = matches[i].game_start - prev_end;
+    Session current{.index = 0, .begin = 0, .end = 1};
 
-        if (gap > gap_threshold) {
-            sessions.push_back(std::move(current));
-            current = Session{};
-            current.index = static_cast<int>(sessions.size());
+    for (int i = 1; i < n; ++i) {
+        if (gap_exceeded(i)) {
+            sessions.push_back(current);
+            current = Session{.index = static_cast<int>(sessions.size()), .begin = i, .end = i};
         }
-
-        current.matches.push_back(matches[i]);
+        current.end = i + 1;
     }
 
-    sessions.push_back(std::move(current));
+    sessions.push_back(current);
     return sessions;
 }
 
+} // namespace
+
+std::vector<Session> detect_sessions(
+    const MatchTable& table,
+    std::chrono::minutes gap_threshold) {
+
+    auto gap_secs = std::chrono::duration_cast<std::chrono::seconds>(gap_threshold).count();
+    return split_sessions(static_cast<int>(table.size()), [&](int i) {
+        return table.start[i] - table.end(i - 1) > gap_secs;
+    });
+}
+
+std::vector<Session> detect_sessions(
+    const std::vector<PlayerMatchSummary>& matches,
+    std::chrono::minutes gap_threshold) {
+
+    return split_sessions(static_cast<int>(matches.size()), [&](int i) {
+        auto& prev = matches[i - 1];
+        auto prev_end = prev.game_start + std::chrono::seconds(prev.game_length_secs);
+        return matches[i].game_start - prev_end > gap_threshold;
+    });
+}
+
 } // namespace valorant
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "valorant/analytics.hpp"
 #include "valorant/session_detector.hpp"
+#include <algorithm>
+#include <cmath>
 
 using namespace valorant;
 using namespace std::chrono;
@@ -11,7 +13,7 @@ PlayerMatchSummary make_match(int kills, int deaths, int assists, bool won,
                               int rr, int hour, int game_len_secs = 2400,
                               int damage = 3000, int rounds = 24) {
     PlayerMatchSummary m;
-    m.match_id = "match-" + std::to_string(rand());
+    m.match_id = MatchId::parse("match-" + std::to_string(rand()));
     m.kills = kills;
     m.deaths = deaths;
     m.assists = assists;
@@ -39,6 +41,17 @@ std::vector<PlayerMatchSummary> make_session_matches(int count, int start_hour =
     return matches;
 }
 
+// Appends a session's matches to `matches` and records it as a row range.
+void add_session(std::vector<PlayerMatchSummary>& matches, std::vector<Session>& sessions,
+                 const std::vector<PlayerMatchSummary>& session_matches) {
+    Session session;
+    session.index = static_cast<int>(sessions.size());
+    session.begin = static_cast<int>(matches.size());
+    matches.insert(matches.end(), session_matches.begin(), session_matches.end());
+    session.end = static_cast<int>(matches.size());
+    sessions.push_back(session);
+}
+
 } // namespace
 
 TEST(Analytics, KdaCalculation) {
@@ -90,7 +103,7 @@ TEST(PerformanceByHour, BucketsMatchesByHour) {
 }
 
 TEST(PerformanceByHour, EmptyInput) {
-    auto result = performance_by_hour({});
+    auto result = performance_by_hour(std::vector<PlayerMatchSummary>{});
     EXPECT_TRUE(result.empty());
 }
 
@@ -106,21 +119,74 @@ TEST(RollingKda, WindowLargerThanData) {
     EXPECT_EQ(result.size(), 1u); // uses effective window = 3
 }
 
+TEST(RollingKda, IndexesBackIntoTable) {
+    auto matches = make_session_matches(10);
+    auto table = MatchTable::from_matches(matches);
+    auto result = rolling_kda(table, 4);
+    ASSERT_EQ(result.size(), 7u);
+    EXPECT_EQ(result.match_index(0), 3);
+    EXPECT_EQ(rolling_match_id(table, result, 6), matches[9].match_id);
+    EXPECT_DOUBLE_EQ(result[0], (matches[0].kda() + matches[1].kda() +
+                                 matches[2].kda() + matches[3].kda()) / 4);
+    EXPECT_TRUE(rolling_kda(std::vector<PlayerMatchSummary>{}, 4).empty());
+}
+
 TEST(RollingKda, ValuesInReasonableRange) {
     auto matches = make_session_matches(10);
     auto result = rolling_kda(matches, 5);
-    for (auto& m : result) {
-        EXPECT_GE(m.value, 0.0);
-        EXPECT_LE(m.value, 50.0);
+    for (double v : result) {
+        EXPECT_GE(v, 0.0);
+        EXPECT_LE(v, 50.0);
     }
 }
 
+TEST(RollingMetrics, MatchesNaiveWindowMeans) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < 300; ++i) {
+        matches.push_back(make_match(5 + i * 7 % 23, i * 5 % 17, i % 9, i % 3 != 1,
+                                     i % 3 != 1 ? 18 : -14, i, 2400,
+                                     1500 + i * 37 % 2000, 13 + i % 12));
+    }
+    auto table = MatchTable::from_matches(matches);
+
+    const RollingStat stats[] = {RollingStat::Kda, RollingStat::WinRate,
+                                 RollingStat::DamagePerRound, RollingStat::RrChange};
+    const int windows[] = {5, 10, 20, 50, 1000};
+    auto set = rolling_metrics(table, stats, windows);
+    ASSERT_EQ(set.series.size(), 20u);
+
+    auto value = [&](RollingStat stat, const PlayerMatchSummary& m) {
+        switch (stat) {
+            case RollingStat::Kda: return m.kda();
+            case RollingStat::WinRate: return m.won ? 1.0 : 0.0;
+            case RollingStat::DamagePerRound: return m.damage_per_round();
+            case RollingStat::RrChange: return static_cast<double>(m.rr_change);
+        }
+        return 0.0;
+    };
+
+    for (auto stat : stats) {
+        for (int window : windows) {
+            auto* series = set.find(stat, window);
+            ASSERT_NE(series, nullptr);
+            int w = std::min(window, 300);
+            ASSERT_EQ(series->size(), static_cast<size_t>(300 - w + 1));
+            for (size_t i = 0; i < series->size(); ++i) {
+                double sum = 0.0;
+                for (int j = 0; j < w; ++j) sum += value(stat, matches[i + j]);
+                EXPECT_NEAR((*series)[i], sum / w, 1e-9);
+            }
+        }
+    }
+    EXPECT_EQ(set.find(RollingStat::Kda, 7), nullptr);
+}
+
 TEST(RollingWinRate, BoundedZeroOne) {
     auto matches = make_session_matches(10);
     auto result = rolling_win_rate(matches, 5);
-    for (auto& m : result) {
-        EXPECT_GE(m.value, 0.0);
-        EXPECT_LE(m.value, 1.0);
+    for (double v : result) {
+        EXPECT_GE(v, 0.0);
+        EXPECT_LE(v, 1.0);
     }
 }
 
@@ -130,8 +196,8 @@ TEST(RollingWinRate, AllWins) {
         matches.push_back(make_match(20, 10, 5, true, 15, i));
     }
     auto result = rolling_win_rate(matches, 5);
-    for (auto& m : result) {
-        EXPECT_DOUBLE_EQ(m.value, 1.0);
+    for (double v : result) {
+        EXPECT_DOUBLE_EQ(v, 1.0);
     }
 }
 
@@ -141,15 +207,15 @@ TEST(RollingWinRate, AllLosses) {
         matches.push_back(make_match(5, 15, 2, false, -15, i));
     }
     auto result = rolling_win_rate(matches, 5);
-    for (auto& m : result) {
-        EXPECT_DOUBLE_EQ(m.value, 0.0);
+    for (double v : result) {
+        EXPECT_DOUBLE_EQ(v, 0.0);
     }
 }
 
 TEST(SessionPerformance, CorrectGameCount) {
     auto matches = make_session_matches(5);
     auto sessions = detect_sessions(matches);
-    auto result = performance_by_session(sessions);
+    auto result = performance_by_session(matches, sessions);
     ASSERT_EQ(result.size(), 1u);
     EXPECT_EQ(result[0].game_count, 5);
     EXPECT_EQ(result[0].games.size(), 5u);
@@ -158,7 +224,7 @@ TEST(SessionPerformance, CorrectGameCount) {
 TEST(SessionPerformance, GameNumbersSequential) {
     auto matches = make_session_matches(4);
     auto sessions = detect_sessions(matches);
-    auto result = performance_by_session(sessions);
+    auto result = performance_by_session(matches, sessions);
     for (int i = 0; i < 4; ++i) {
         EXPECT_EQ(result[0].games[i].game_number, i + 1);
     }
@@ -166,15 +232,13 @@ TEST(SessionPerformance, GameNumbersSequential) {
 
 TEST(DecayCurve, NegativeSlopeForFatigueData) {
     // Build sessions with declining performance
+    std::vector<PlayerMatchSummary> matches;
     std::vector<Session> sessions;
     for (int s = 0; s < 5; ++s) {
-        Session session;
-        session.index = s;
-        session.matches = make_session_matches(5, s * 10);
-        sessions.push_back(session);
+        add_session(matches, sessions, make_session_matches(5, s * 10));
     }
 
-    auto result = decay_curve(sessions, 3);
+    auto result = decay_curve(matches, sessions, 3);
     EXPECT_LT(result.slope, 0.0);
     EXPECT_FALSE(result.points.empty());
     EXPECT_GE(result.r_squared, 0.0);
@@ -182,38 +246,438 @@ TEST(DecayCurve, NegativeSlopeForFatigueData) {
 }
 
 TEST(DecayCurve, PointsSortedByPosition) {
+    std::vector<PlayerMatchSummary> matches;
     std::vector<Session> sessions;
     for (int s = 0; s < 3; ++s) {
-        Session session;
-        session.index = s;
-        session.matches = make_session_matches(4, s * 10);
-        sessions.push_back(session);
+        add_session(matches, sessions, make_session_matches(4, s * 10));
     }
 
-    auto result = decay_curve(sessions, 3);
+    auto result = decay_curve(matches, sessions, 3);
     for (size_t i = 1; i < result.points.size(); ++i) {
         EXPECT_GT(result.points[i].first, result.points[i - 1].first);
     }
 }
 
 TEST(DecayCurve, SkipsShortSessions) {
+    std::vector<PlayerMatchSummary> matches;
     std::vector<Session> sessions;
-    Session short_session;
-    short_session.index = 0;
-    short_session.matches = make_session_matches(2);
-    sessions.push_back(short_session);
+    add_session(matches, sessions, make_session_matches(2));
 
-    auto result = decay_curve(sessions, 3);
+    auto result = decay_curve(matches, sessions, 3);
     EXPECT_TRUE(result.points.empty());
 }
 
+TEST(SessionPerformance, UsesSessionRowRange) {
+    std::vector<PlayerMatchSummary> matches;
+    std::vector<Session> sessions;
+    add_session(matches, sessions, make_session_matches(2));
+    add_session(matches, sessions, make_session_matches(3, 10));
+
+    auto result = performance_by_session(MatchTable::from_matches(matches), sessions);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[1].game_count, 3);
+    EXPECT_DOUBLE_EQ(result[1].games[0].kda, matches[2].kda());
+}
+
 TEST(RrBySession, TotalRrSumsCorrectly) {
     auto matches = make_session_matches(4);
     auto sessions = detect_sessions(matches);
-    auto result = rr_by_session(sessions);
+    auto result = rr_by_session(matches, sessions);
     ASSERT_EQ(result.size(), 1u);
 
     int expected_total = 0;
     for (auto& m : matches) expected_total += m.rr_change;
     EXPECT_EQ(result[0].total_rr, expected_total);
 }
+
+TEST(WeekdayHourHeatmap, CellsRollUpToHourlyBuckets) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < 200; ++i) {
+        matches.push_back(make_match(10 + i % 9, 8 + i % 5, 4, i % 3 != 0, i % 3 ? 18 : -16, i * 7));
+    }
+    auto table = MatchTable::from_matches(matches);
+    auto heatmap = performance_by_weekday_hour(table);
+
+    int total = 0;
+    for (int d = 0; d < WeekHourHeatmap::days; ++d) {
+        for (int h = 0; h < WeekHourHeatmap::hours; ++h) total += heatmap.at(d, h).match_count;
+    }
+    EXPECT_EQ(total, 200);
+
+    for (auto& hour : performance_by_hour(table)) {
+        int games = 0, wins = 0;
+        double kda = 0.0;
+        for (int d = 0; d < WeekHourHeatmap::days; ++d) {
+            auto& cell = heatmap.at(d, hour.hour);
+            games += cell.match_count;
+            wins += static_cast<int>(std::lround(cell.win_rate * cell.match_count));
+            kda += cell.avg_kda * cell.match_count;
+        }
+        EXPECT_EQ(games, hour.match_count);
+        EXPECT_NEAR(static_cast<double>(wins) / games, hour.win_rate, 1e-12);
+        EXPECT_NEAR(kda / games, hour.avg_kda, 1e-9);
+    }
+
+    auto cell = heatmap.at(table.local_weekday[0], table.local_hour[0]);
+    EXPECT_GT(cell.match_count, 0);
+    EXPECT_NE(cell.avg_rr, 0.0);
+
+    auto fused = aggregate_matches(table);
+    for (size_t c = 0; c < heatmap.cells.size(); ++c) {
+        EXPECT_EQ(fused.heatmap.cells[c].match_count, heatmap.cells[c].match_count);
+        EXPECT_EQ(fused.heatmap.cells[c].avg_kda, heatmap.cells[c].avg_kda);
+    }
+}
+
+TEST(GapSweep, MatchesDetectSessionsAtEveryThreshold) {
+    // Gaps between games vary from 5 to 200 minutes
+    std::vector<PlayerMatchSummary> matches;
+    auto t = system_clock::from_time_t(1700000000);
+    for (int i = 0; i < 80; ++i) {
+        auto m = make_match(20 - (i * 7) % 13, 10 + i % 4, 3, i % 2 == 0, 0, 0, 1800);
+        m.game_start = t;
+        matches.push_back(m);
+        t += seconds(1800) + minutes(5 + (i * 37) % 196);
+    }
+    auto table = MatchTable::from_matches(matches);
+
+    std::vector<int> gaps = {180, 15, 45, 90, 60, 30, 120};
+    auto sweep = sweep_gap_thresholds(table, gaps);
+    ASSERT_EQ(sweep.size(), gaps.size());
+    std::ranges::sort(gaps);
+
+    for (size_t k = 0; k < gaps.size(); ++k) {
+        auto sessions = detect_sessions(table, minutes(gaps[k]));
+        auto decay = decay_curve(table, sessions, 3, DecayWeighting::Samples);
+        int qualifying = static_cast<int>(std::ranges::count_if(
+            sessions, [](const Session& s) { return s.game_count() >= 3; }));
+
+        EXPECT_EQ(sweep[k].gap_minutes, gaps[k]);
+        EXPECT_EQ(sweep[k].session_count, static_cast<int>(sessions.size()));
+        EXPECT_DOUBLE_EQ(sweep[k].avg_session_length, 80.0 / sessions.size());
+        EXPECT_EQ(sweep[k].qualifying_sessions, qualifying);
+        EXPECT_NEAR(sweep[k].decay_slope, decay.slope, 1e-9) << "gap " << gaps[k];
+    }
+}
+
+TEST(PerformanceByAgent, GroupsByInternedAgent) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < 3; ++i) {
+        auto m = make_match(20, 10, 0, true, 15, i);
+        m.agent_id = agent_names().intern("Jett");
+        matches.push_back(m);
+    }
+    auto m = make_match(5, 10, 0, false, -15, 3);
+    m.agent_id = agent_names().intern("Sage");
+    matches.push_back(m);
+
+    auto result = performance_by_agent(matches);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].agent, "Jett");
+    EXPECT_EQ(result[0].games, 3);
+    EXPECT_DOUBLE_EQ(result[0].avg_kda, 2.0);
+    EXPECT_DOUBLE_EQ(result[0].pick_rate, 0.75);
+    EXPECT_EQ(result[1].agent, "Sage");
+    EXPECT_DOUBLE_EQ(result[1].win_rate, 0.0);
+}
+
+TEST(PerformanceByAgent, MedianResistsOutlierGame) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < 4; ++i) {
+        auto m = make_match(10, 10, 0, true, 15, i);
+        m.agent_id = agent_names().intern("Omen");
+        matches.push_back(m);
+    }
+    auto stomp = make_match(40, 1, 0, true, 15, 4);
+    stomp.agent_id = agent_names().intern("Omen");
+    matches.push_back(stomp);
+
+    auto result = performance_by_agent(matches);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_DOUBLE_EQ(result[0].avg_kda, 8.8);
+    EXPECT_DOUBLE_EQ(result[0].kda_quantiles.p50, 1.0);
+    EXPECT_DOUBLE_EQ(result[0].kda_quantiles.p10, 1.0);
+    EXPECT_GT(result[0].kda_quantiles.p90, 1.0);
+    EXPECT_DOUBLE_EQ(result[0].dpr_quantiles.p50, 125.0);
+}
+
+TEST(PerformanceByMap, GroupsByInternedMap) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < 4; ++i) {
+        auto m = make_match(10, 10, 0, i % 2 == 0, 0, i);
+        m.map_id = map_names().intern(i < 3 ? "Ascent" : "Bind");
+        matches.push_back(m);
+    }
+
+    auto result = performance_by_map(matches);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].map, "Ascent");
+    EXPECT_EQ(result[0].games, 3);
+    EXPECT_EQ(result[1].map, "Bind");
+    EXPECT_DOUBLE_EQ(result[1].win_rate, 0.0);
+}
+
+TEST(AgentMapCrossTab, CellsAndMarginalsMatchGroupedAnalyses) {
+    const char* agents[] = {"Jett", "Sage", "Omen"};
+    const char* maps[] = {"Ascent", "Bind", "Icebox", "Sunset"};
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < 60; ++i) {
+        auto m = make_match(8 + i % 11, 6 + i % 7, i % 5, i % 3 == 0, 0, i, 2400, 2000 + 37 * i);
+        m.agent_id = agent_names().intern(agents[(i * i) % 3]);
+        m.map_id = map_names().intern(maps[i % 4 == 3 && i > 20 ? 3 : i % 3]);
+        m.score = 150 + i;
+        matches.push_back(m);
+    }
+    auto table = MatchTable::from_matches(matches);
+    auto tab = agent_map_crosstab(table);
+
+    auto by_agent = performance_by_agent(table);
+    auto by_map = performance_by_map(table);
+    ASSERT_EQ(tab.agent_totals.size(), by_agent.size());
+    ASSERT_EQ(tab.map_totals.size(), by_map.size());
+    for (size_t a = 0; a < by_agent.size(); ++a) {
+        EXPECT_EQ(tab.agent_totals[a].agent, by_agent[a].agent);
+        EXPECT_EQ(tab.agent_totals[a].avg_kda, by_agent[a].avg_kda);
+        EXPECT_EQ(tab.agent_totals[a].avg_damage_per_round, by_agent[a].avg_damage_per_round);
+    }
+    for (size_t m = 0; m < by_map.size(); ++m) {
+        EXPECT_EQ(tab.map_totals[m].map, by_map[m].map);
+        EXPECT_EQ(tab.map_totals[m].avg_score, by_map[m].avg_score);
+    }
+
+    ASSERT_EQ(tab.cells.size(), by_agent.size() * by_map.size());
+    for (size_t a = 0; a < by_agent.size(); ++a) {
+        int games = 0;
+        double kda = 0.0;
+        for (size_t m = 0; m < by_map.size(); ++m) {
+            games += tab.at(a, m).games;
+            kda += tab.at(a, m).avg_kda * tab.at(a, m).games;
+        }
+        EXPECT_EQ(games, by_agent[a].games);
+        EXPECT_NEAR(kda / games, by_agent[a].avg_kda, 1e-9);
+    }
+    for (size_t m = 0; m < by_map.size(); ++m) {
+        int games = 0;
+        for (size_t a = 0; a < by_agent.size(); ++a) games += tab.at(a, m).games;
+        EXPECT_EQ(games, by_map[m].games);
+    }
+
+    // One cell checked against the rows it covers; Jett never played Bind
+    size_t jett = 0, sage = 0, bind = 0;
+    while (tab.agent_totals[jett].agent != "Jett") ++jett;
+    while (tab.agent_totals[sage].agent != "Sage") ++sage;
+    while (tab.map_totals[bind].map != "Bind") ++bind;
+    EXPECT_EQ(tab.at(jett, bind).games, 0);
+    int games = 0, wins = 0;
+    for (size_t i = 0; i < table.size(); ++i) {
+        if (agent_names().name(table.agent_id[i]) != "Sage") continue;
+        if (map_names().name(table.map_id[i]) != "Bind") continue;
+        games++;
+        wins += table.won(i) ? 1 : 0;
+    }
+    ASSERT_GT(games, 0);
+    EXPECT_EQ(tab.at(sage, bind).games, games);
+    EXPECT_DOUBLE_EQ(tab.at(sage, bind).win_rate, static_cast<double>(wins) / games);
+}
+
+TEST(AggregateMatches, ParallelMatchesSerialAcrossChunks) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < 50000; ++i) {
+        // A win streak covers the whole second chunk and both its boundaries
+        bool won = (i >= 16000 && i < 34000) || i % 7 < 3;
+        auto m = make_match(5 + i % 23, i % 17, i % 9, won, won ? 18 : -14, i,
+                            2400, 1500 + i * 37 % 2000, 13 + i % 12);
+        m.agent_id = agent_names().intern(i % 3 ? "Jett" : "Sova");
+        m.map_id = map_names().intern(i % 5 ? "Ascent" : "Pearl");
+        matches.push_back(m);
+    }
+    auto table = MatchTable::from_matches(matches);
+
+    ThreadPool pool(4);
+    auto serial = aggregate_matches(table, 50);
+    auto parallel = aggregate_matches(table, 50, pool);
+
+    ASSERT_EQ(serial.agents.size(), parallel.agents.size());
+    for (size_t i = 0; i < serial.agents.size(); ++i) {
+        EXPECT_EQ(serial.agents[i].avg_kda, parallel.agents[i].avg_kda);
+        EXPECT_EQ(serial.agents[i].avg_damage_per_round, parallel.agents[i].avg_damage_per_round);
+    }
+    ASSERT_EQ(serial.hourly.size(), parallel.hourly.size());
+    for (size_t i = 0; i < serial.hourly.size(); ++i) {
+        EXPECT_EQ(serial.hourly[i].avg_kda, parallel.hourly[i].avg_kda);
+    }
+    EXPECT_EQ(serial.overview.avg_damage_per_round, parallel.overview.avg_damage_per_round);
+    EXPECT_TRUE(std::ranges::equal(serial.rolling_kda, parallel.rolling_kda));
+
+    ASSERT_EQ(serial.crosstab.cells.size(), parallel.crosstab.cells.size());
+    for (size_t c = 0; c < serial.crosstab.cells.size(); ++c) {
+        EXPECT_EQ(serial.crosstab.cells[c].games, parallel.crosstab.cells[c].games);
+        EXPECT_EQ(serial.crosstab.cells[c].avg_kda, parallel.crosstab.cells[c].avg_kda);
+    }
+    // The grid comes from the same pass as the agent and map tables
+    auto& tab = parallel.crosstab;
+    ASSERT_EQ(tab.agent_totals.size(), parallel.agents.size());
+    ASSERT_EQ(tab.map_totals.size(), parallel.maps.size());
+    for (size_t a = 0; a < parallel.agents.size(); ++a) {
+        EXPECT_EQ(tab.agent_totals[a].agent, parallel.agents[a].agent);
+        int games = 0;
+        for (size_t m = 0; m < parallel.maps.size(); ++m) games += tab.at(a, m).games;
+        EXPECT_EQ(games, parallel.agents[a].games);
+    }
+
+    auto expected = compute_overview(table, serial.agents, serial.maps);
+    EXPECT_EQ(parallel.overview.wins, expected.wins);
+    EXPECT_EQ(parallel.overview.total_kills, expected.total_kills);
+    EXPECT_EQ(parallel.overview.longest_win_streak, expected.longest_win_streak);
+    EXPECT_EQ(parallel.overview.longest_loss_streak, expected.longest_loss_streak);
+    EXPECT_EQ(parallel.overview.current_streak, expected.current_streak);
+    EXPECT_GE(parallel.overview.longest_win_streak, 18000);
+    EXPECT_NEAR(parallel.overview.avg_damage_per_round, expected.avg_damage_per_round, 1e-9);
+}
+
+TEST(AnalyticsState, IncrementalMatchesBatch) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int s = 0; s < 12; ++s) {
+        auto session = make_session_matches(1 + s % 5, s * 10);
+        for (auto& m : session) {
+            m.agent_id = agent_names().intern(s % 2 ? "Jett" : "Killjoy");
+            m.map_id = map_names().intern(s % 3 ? "Haven" : "Split");
+        }
+        matches.insert(matches.end(), session.begin(), session.end());
+    }
+    auto table = MatchTable::from_matches(matches);
+
+    AnalyticsState state(4);
+    for (size_t from = 0; from < table.size(); from += 5) {
+        auto end = std::min(table.size(), from + 5);
+        state.ingest(std::vector<PlayerMatchSummary>(matches.begin() + from, matches.begin() + end));
+        ASSERT_EQ(state.match_count(), end);
+    }
+
+    auto batch = aggregate_matches(table, 4);
+    auto overview = state.overview();
+    EXPECT_EQ(overview.wins, batch.overview.wins);
+    EXPECT_EQ(overview.avg_damage_per_round, batch.overview.avg_damage_per_round);
+    EXPECT_EQ(overview.current_streak, batch.overview.current_streak);
+    EXPECT_EQ(overview.best_agent, batch.overview.best_agent);
+    ASSERT_EQ(state.agents().size(), batch.agents.size());
+    EXPECT_EQ(state.agents()[0].avg_kda, batch.agents[0].avg_kda);
+    ASSERT_EQ(state.hourly().size(), batch.hourly.size());
+    for (size_t c = 0; c < batch.heatmap.cells.size(); ++c) {
+        EXPECT_EQ(state.heatmap().cells[c].avg_rr, batch.heatmap.cells[c].avg_rr);
+    }
+    EXPECT_EQ(state.rolling_kda().first_index, batch.rolling_kda.first_index);
+    EXPECT_TRUE(std::ranges::equal(state.rolling_kda(), batch.rolling_kda));
+    EXPECT_TRUE(std::ranges::equal(state.rolling_wr(), batch.rolling_wr));
+
+    auto sessions = detect_sessions(table);
+    auto expected = performance_by_session(table, sessions);
+    ASSERT_EQ(state.sessions().size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(state.sessions()[i].game_count, expected[i].game_count);
+        EXPECT_EQ(state.sessions()[i].total_rr, expected[i].total_rr);
+        EXPECT_EQ(state.sessions()[i].avg_kda, expected[i].avg_kda);
+    }
+
+    auto decay = state.decay();
+    auto expected_decay = decay_curve(table, sessions);
+    EXPECT_EQ(decay.points, expected_decay.points);
+    EXPECT_EQ(decay.slope, expected_decay.slope);
+    ASSERT_EQ(decay.point_quantiles.size(), decay.points.size());
+    for (size_t i = 0; i < decay.points.size(); ++i) {
+        EXPECT_EQ(decay.point_quantiles[i].p50, expected_decay.point_quantiles[i].p50);
+    }
+}
+
+TEST(AnalyticsState, ReportMatchesBatchAcrossIngests) {
+    auto table = MatchTable::from_matches(make_session_matches(6));
+    AnalyticsState state(4);
+    state.ingest(table);
+
+    // The second batch plays a name interned after the first ingest
+    auto later = make_session_matches(5, 300);
+    for (auto& m : later) {
+        m.agent_id = agent_names().intern("ReportStateAgent");
+        m.map_id = map_names().intern("ReportStateMap");
+        table.push_back(m);
+    }
+    state.ingest(table, 6);
+
+    auto report = state.report();
+    auto batch = aggregate_matches(table, 4);
+    auto sessions = detect_sessions(table);
+    EXPECT_EQ(report.match_count, 11);
+    EXPECT_EQ(report.overview.wins, batch.overview.wins);
+    EXPECT_EQ(report.overview.best_agent, batch.overview.best_agent);
+    ASSERT_EQ(report.agents.size(), batch.agents.size());
+    EXPECT_EQ(report.agents[0].agent, batch.agents[0].agent);
+    ASSERT_EQ(report.crosstab.cells.size(), batch.crosstab.cells.size());
+    for (size_t c = 0; c < batch.crosstab.cells.size(); ++c) {
+        EXPECT_EQ(report.crosstab.cells[c].games, batch.crosstab.cells[c].games);
+        EXPECT_EQ(report.crosstab.cells[c].avg_kda, batch.crosstab.cells[c].avg_kda);
+    }
+    EXPECT_TRUE(std::ranges::equal(report.rolling_kda, batch.rolling_kda));
+    EXPECT_EQ(report.sessions.size(), performance_by_session(table, sessions).size());
+    EXPECT_EQ(report.rr_sessions.size(), report.sessions.size());
+    EXPECT_EQ(report.decay.slope, decay_curve(table, sessions).slope);
+    EXPECT_EQ(report.gap_minutes, 45);
+    EXPECT_EQ(report.min_session_length, 3);
+}
+
+TEST(AnalyticsState, ShortHistoryUsesWholeWindow) {
+    auto matches = make_session_matches(3);
+    AnalyticsState state(20);
+    state.ingest(matches);
+    auto expected = rolling_kda(matches, 20);
+    ASSERT_EQ(state.rolling_kda().size(), 1u);
+    EXPECT_EQ(state.rolling_kda().first_index, expected.first_index);
+    EXPECT_EQ(state.rolling_kda()[0], expected[0]);
+}
+
+TEST(AnalyticsState, NonPositiveWindowMatchesBatch) {
+    auto matches = make_session_matches(3);
+    for (int window : {0, -4}) {
+        AnalyticsState state(window);
+        state.ingest(matches);
+        EXPECT_TRUE(rolling_kda(matches, window).empty());
+        EXPECT_TRUE(state.rolling_kda().empty());
+        EXPECT_TRUE(state.rolling_wr().empty());
+        EXPECT_EQ(state.match_count(), 3u);
+    }
+}
+
+TEST(DecayCurve, SampleWeightedMatchesPerGameRegression) {
+    // Sessions of different lengths, so later positions have fewer samples
+    std::vector<std::pair<double, double>> samples; // (position, kda)
+    DecayAccumulator first, second;
+    for (int s = 0; s < 9; ++s) {
+        int len = 2 + s % 6;
+        for (int pos = 1; pos <= len; ++pos) {
+            double kda = 2.5 - 0.1 * pos + 0.07 * ((s * 5 + pos * 3) % 7);
+            samples.emplace_back(pos, kda);
+            (s < 4 ? first : second).add(pos, kda);
+        }
+    }
+    first.merge(second);
+    auto model = first.fit(DecayWeighting::Samples);
+
+    double n = samples.size(), mx = 0, my = 0;
+    for (auto& [x, y] : samples) { mx += x / n; my += y / n; }
+    double sxx = 0, sxy = 0;
+    for (auto& [x, y] : samples) { sxx += (x - mx) * (x - mx); sxy += (x - mx) * (y - my); }
+    double slope = sxy / sxx;
+    double intercept = my - slope * mx;
+    double ss_res = 0;
+    for (auto& [x, y] : samples) ss_res += (y - slope * x - intercept) * (y - slope * x - intercept);
+
+    EXPECT_NEAR(model.slope, slope, 1e-9);
+    EXPECT_NEAR(model.intercept, intercept, 1e-9);
+    EXPECT_NEAR(model.slope_std_error, std::sqrt(ss_res / (n - 2) / sxx), 1e-9);
+    ASSERT_EQ(model.sample_counts.size(), 7u);
+    EXPECT_EQ(model.sample_counts[0], 9);
+    EXPECT_EQ(model.sample_counts[6], 1);
+
+    auto unweighted = first.fit();
+    EXPECT_NE(unweighted.slope, model.slope);
+    EXPECT_GT(unweighted.slope_std_error, 0.0);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "valorant/analytics.hpp"
+#include "valorant/bootstrap.hpp"
+#include "valorant/session_detector.hpp"
+#include <cmath>
+
+using namespace valorant;
+using namespace std::chrono;
+
+namespace {
+
+// `count` sessions of 3-6 games; KDA falls by `decay` per game plus noise.
+MatchTable make_sessions(int count, double decay) {
+    std::vector<PlayerMatchSummary> matches;
+    auto t = system_clock::from_time_t(1700000000);
+    for (int s = 0; s < count; ++s) {
+        int len = 3 + s % 4;
+        for (int g = 0; g < len; ++g) {
+            PlayerMatchSummary m;
+            m.game_start = t;
+            m.game_length_secs = 1800;
+            int noise = (s * 7 + g * 13) % 11 - 5;
+            m.kills = std::max(0, static_cast<int>(20 - decay * g * 10) + noise);
+            m.deaths = 10;
+            matches.push_back(m);
+            t += minutes(35);
+        }
+        t += hours(10);
+    }
+    return MatchTable::from_matches(matches);
+}
+
+} // namespace
+
+TEST(Bootstrap, DeterministicAcrossThreadCounts) {
+    auto table = make_sessions(60, 0.1);
+    auto sessions = detect_sessions(table);
+    BootstrapOptions options{.replicates = 500, .seed = 42};
+
+    ThreadPool one(1), four(4);
+    auto a = bootstrap_decay_slope(table, sessions, options, one);
+    auto b = bootstrap_decay_slope(table, sessions, options, four);
+    EXPECT_EQ(a.replicates, 500);
+    EXPECT_EQ(a.ci_low, b.ci_low);
+    EXPECT_EQ(a.ci_high, b.ci_high);
+    EXPECT_EQ(a.p_value, b.p_value);
+
+    options.seed = 43;
+    auto c = bootstrap_decay_slope(table, sessions, options, four);
+    EXPECT_NE(a.ci_low, c.ci_low);
+}
+
+TEST(Bootstrap, StrongDecayIsSignificant) {
+    auto table = make_sessions(80, 0.15);
+    auto sessions = detect_sessions(table);
+    ThreadPool pool(4);
+    auto boot = bootstrap_decay_slope(table, sessions, {}, pool);
+    auto slope = decay_curve(table, sessions).slope;
+
+    EXPECT_LT(boot.ci_high, 0.0);
+    EXPECT_LE(boot.ci_low, slope);
+    EXPECT_GE(boot.ci_high, slope);
+    EXPECT_LT(boot.p_value, 0.01);
+}
+
+TEST(Bootstrap, FlatPerformanceIsNotSignificant) {
+    auto table = make_sessions(80, 0.0);
+    auto sessions = detect_sessions(table);
+    ThreadPool pool(4);
+    auto boot = bootstrap_decay_slope(table, sessions, {}, pool);
+    EXPECT_LT(boot.ci_low, 0.0);
+    EXPECT_GT(boot.ci_high, 0.0);
+    EXPECT_GT(boot.p_value, 0.05);
+}
+
+TEST(Bootstrap, TooFewSessions) {
+    auto table = make_sessions(1, 0.1);
+    ThreadPool pool(2);
+    auto boot = bootstrap_decay_slope(table, detect_sessions(table), {}, pool);
+    EXPECT_EQ(boot.replicates, 0);
+}
+
+TEST(Bootstrap, PValueNeverZero) {
+    auto table = make_sessions(80, 0.15);
+    auto sessions = detect_sessions(table);
+    ThreadPool pool(4);
+    auto boot = bootstrap_decay_slope(table, sessions, {.replicates = 200}, pool);
+    ASSERT_EQ(boot.replicates, 200);
+    ASSERT_LT(boot.ci_high, 0.0); // every replicate is negative
+    EXPECT_DOUBLE_EQ(boot.p_value, 2.0 / 201.0);
+}
+
+TEST(Bootstrap, ConfidenceOutsideUnitIntervalIsRejected) {
+    auto table = make_sessions(20, 0.1);
+    auto sessions = detect_sessions(table);
+    ThreadPool pool(2);
+    for (double confidence : {0.0, 1.0, -0.5, 1.5, std::nan("")}) {
+        auto boot = bootstrap_decay_slope(table, sessions, {.confidence = confidence}, pool);
+        EXPECT_EQ(boot.replicates, 0) << confidence;
+    }
+}
@@ -0,0 +1,432 @@
+#include <gtest/gtest.h>
+#include "valorant/cache.hpp"
+#include "valorant/crc32c.hpp"
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace valorant;
+
+namespace {
+
+class CacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir = "test_cache_dir";
+
+    void SetUp() override { std::filesystem::remove_all(dir); }
+    void TearDown() override { std::filesystem::remove_all(dir); }
+
+    void flip_byte(const std::filesystem::path& path, std::streamoff offset) {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekg(offset);
+        char c = 0;
+        f.get(c);
+        f.seekp(offset);
+        f.put(static_cast<char>(c ^ 0x20));
+    }
+};
+
+} // namespace
+
+TEST(Crc32c, KnownVector) {
+    std::string s = "123456789";
+    EXPECT_EQ(crc32c(s.data(), s.size()), 0xE3069283u);
+}
+
+TEST(Crc32c, EmptyInput) {
+    EXPECT_EQ(crc32c(nullptr, 0), 0u);
+}
+
+TEST(Crc32c, IncrementalMatchesOneShot) {
+    std::string s(1000, '\0');
+    for (size_t i = 0; i < s.size(); ++i) s[i] = static_cast<char>(i * 31);
+
+    auto whole = crc32c(s.data(), s.size());
+    auto part = crc32c(s.data(), 13);
+    part = crc32c(s.data() + 13, s.size() - 13, part);
+    EXPECT_EQ(whole, part);
+}
+
+TEST_F(CacheTest, RoundTripsMatch) {
+    Cache cache(dir);
+    nlohmann::json data = {{"meta", {{"id", "abc"}}}, {"kills", 21}};
+    cache.store_match("abc", data);
+
+    auto loaded = cache.get_match("abc");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(*loaded, data);
+}
+
+TEST_F(CacheTest, HasMatchWithoutReading) {
+    Cache cache(dir);
+    EXPECT_FALSE(cache.has_match("abc"));
+    cache.store_match("abc", {{"kills", 1}});
+    EXPECT_TRUE(cache.has_match("abc"));
+    EXPECT_TRUE(Cache(dir).has_match("abc"));
+    EXPECT_EQ(cache.stats().namespaces[0].lookups(), 0u);
+}
+
+TEST_F(CacheTest, MissingRecord) {
+    Cache cache(dir);
+    EXPECT_FALSE(cache.get_match("nope").has_value());
+}
+
+TEST_F(CacheTest, CorruptPayloadRejected) {
+    Cache cache(dir);
+    cache.store_match("abc", {{"kills", 21}, {"deaths", 10}});
+    flip_byte(dir / "matches" / "abc.json", 16);
+
+    Cache reader(dir);
+    EXPECT_FALSE(reader.get_match("abc").has_value());
+    EXPECT_FALSE(reader.get_match("missing").has_value());
+
+    // Damage is counted apart from plain misses
+    auto& matches = reader.stats().namespaces[0];
+    EXPECT_EQ(matches.misses, 2u);
+    EXPECT_EQ(matches.corrupt, 1u);
+}
+
+TEST_F(CacheTest, ReadsLegacyUnframedJson) {
+    std::filesystem::create_directories(dir / "matches");
+    std::ofstream(dir / "matches" / "old.json") << R"({"kills": 7})";
+
+    Cache cache(dir);
+    auto loaded = cache.get_match("old");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ((*loaded)["kills"], 7);
+}
+
+TEST_F(CacheTest, VerifyClassifiesRecords) {
+    Cache cache(dir);
+    cache.store_match("good", {{"kills", 1}});
+    cache.store_match("bad", {{"kills", 2}});
+    cache.store_mmr_history("player", nlohmann::json::array({{{"elo", 40}}}));
+    std::ofstream(dir / "matches" / "old.json") << R"({"kills": 3})";
+    flip_byte(dir / "matches" / "bad.json", 14);
+
+    auto report = cache.verify();
+    EXPECT_EQ(report.scanned, 4);
+    EXPECT_EQ(report.ok, 2);
+    EXPECT_EQ(report.legacy, 1);
+    EXPECT_EQ(report.corrupt, 1);
+    ASSERT_EQ(report.corrupt_by_namespace.size(), 3u);
+    EXPECT_EQ(report.corrupt_by_namespace[0], (std::pair<std::string, int>{"matches", 1}));
+    EXPECT_EQ(report.corrupt_by_namespace[1].second, 0);
+    ASSERT_EQ(report.corrupt_files.size(), 1u);
+    EXPECT_EQ(report.corrupt_files[0].filename(), "bad.json");
+}
+
+TEST_F(CacheTest, PlayerMatchIndexRoundTrips) {
+    Cache cache(dir);
+    cache.store_player_matches("p1", {"m1", "m2"});
+
+    Cache reader(dir);
+    auto ids = reader.get_player_matches("p1");
+    ASSERT_TRUE(ids.has_value());
+    EXPECT_EQ(*ids, (std::vector<std::string>{"m1", "m2"}));
+}
+
+TEST_F(CacheTest, RecentPlayersNewestFirst) {
+    Cache cache(dir);
+    cache.store_player_matches("old", {"m1"});
+    cache.store_player_matches("new", {"m2"});
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(dir / "players" / "old.json", now - std::chrono::hours(2));
+    std::filesystem::last_write_time(dir / "players" / "new.json", now - std::chrono::hours(1));
+
+    EXPECT_EQ(cache.recent_players(5), (std::vector<std::string>{"new", "old"}));
+    EXPECT_EQ(cache.recent_players(1), (std::vector<std::string>{"new"}));
+}
+
+TEST_F(CacheTest, WarmUpServesFromMemory) {
+    {
+        Cache writer(dir);
+        writer.store_match("m1", {{"kills", 1}});
+        writer.store_player_matches("p1", {"m1"});
+        writer.store_mmr_history("p1", nlohmann::json::array());
+    }
+
+    Cache cache(dir);
+    EXPECT_EQ(cache.warm_up({"p1", "unknown"}), 3u);
+
+    // Once warmed, records no longer depend on the files
+    std::filesystem::remove_all(dir / "players");
+    std::filesystem::remove_all(dir / "mmr_history");
+    std::filesystem::remove_all(dir / "matches");
+    EXPECT_EQ(*cache.get_player_matches("p1"), (std::vector<std::string>{"m1"}));
+    EXPECT_TRUE(cache.get_mmr_history("p1").has_value());
+    EXPECT_EQ((*cache.get_match("m1"))["kills"], 1);
+}
+
+TEST_F(CacheTest, WarmUpPreloadsNewestMatchesWithinMemoryBudget) {
+    {
+        Cache writer(dir);
+        writer.store_player_matches("p1", {"a1", "a2", "a3"});
+        writer.store_player_matches("p2", {"b1", "b2"});
+        for (auto id : {"a1", "a2", "a3", "b1", "b2"}) writer.store_match(id, {{"id", id}});
+    }
+
+    // The two indexes leave room for two matches: each player's newest
+    Cache cache(dir, 4);
+    EXPECT_EQ(cache.warm_up({"p1", "p2"}), 4u);
+    auto before = cache.stats().namespaces[0].bytes_read;
+    cache.get_match("a3");
+    cache.get_match("b2");
+    EXPECT_EQ(cache.stats().namespaces[0].bytes_read, before);
+    cache.get_match("a2");
+    EXPECT_GT(cache.stats().namespaces[0].bytes_read, before);
+}
+
+TEST_F(CacheTest, MemoryTierEvictsLeastRecentlyUsed) {
+    Cache cache(dir, 2);
+    cache.store_match("m1", {{"kills", 1}});
+    cache.store_match("m2", {{"kills", 2}});
+    cache.get_match("m1"); // m2 is now the oldest
+    cache.store_match("m3", {{"kills", 3}});
+
+    cache.get_match("m1");
+    cache.get_match("m3");
+    EXPECT_EQ(cache.stats().namespaces[0].bytes_read, 0u);
+
+    EXPECT_EQ((*cache.get_match("m2"))["kills"], 2);
+    EXPECT_GT(cache.stats().namespaces[0].bytes_read, 0u);
+}
+
+TEST_F(CacheTest, TransientReadsBypassMemoryTier) {
+    {
+        Cache writer(dir);
+        writer.store_match("m1", {{"kills", 1}});
+    }
+
+    Cache cache(dir);
+    auto bytes_read = [&] { return cache.stats().namespaces[0].bytes_read; };
+    EXPECT_EQ((*cache.get_match("m1", CacheRead::Transient))["kills"], 1);
+    auto once = bytes_read();
+    EXPECT_GT(once, 0u);
+    cache.get_match("m1", CacheRead::Transient);
+    EXPECT_EQ(bytes_read(), 2 * once); // not remembered, so read from disk again
+
+    cache.get_match("m1");
+    cache.get_match("m1", CacheRead::Transient);
+    EXPECT_EQ(bytes_read(), 3 * once); // a retained record serves transient reads too
+}
+
+TEST_F(CacheTest, WritesVisibleAcrossInstancesSharingDirectory) {
+    Cache a(dir);
+    Cache b(dir);
+    EXPECT_FALSE(b.get_match("m1").has_value());
+
+    a.store_match("m1", {{"kills", 1}});
+    auto seen = b.get_match("m1");
+    ASSERT_TRUE(seen.has_value());
+    EXPECT_EQ((*seen)["kills"], 1);
+
+    // b now holds m1 in memory; a rewrite elsewhere must invalidate it
+    a.store_match("m1", {{"kills", 2}});
+    EXPECT_EQ((*b.get_match("m1"))["kills"], 2);
+}
+
+TEST_F(CacheTest, SharedIndexGrowsAndStaysAuthoritative) {
+    std::filesystem::create_directories(dir);
+    SharedIndex a(dir / "index.bin", 16, [](SharedIndex&) {});
+    SharedIndex b(dir / "index.bin", 16, [](SharedIndex&) {});
+
+    {
+        auto guard = a.lock();
+        for (int i = 0; i < 200; ++i) {
+            ASSERT_TRUE(a.publish("matches", "m" + std::to_string(i), i, 10).has_value());
+        }
+    }
+
+    EXPECT_GE(a.capacity(), 256u);
+    // b still mapped the original table; it must follow the rename
+    for (auto* index : {&a, &b}) {
+        EXPECT_TRUE(index->authoritative());
+        for (int i = 0; i < 200; ++i) {
+            auto entry = index->find("matches", "m" + std::to_string(i));
+            ASSERT_TRUE(entry.has_value());
+            EXPECT_EQ(entry->written, i);
+        }
+        EXPECT_FALSE(index->find("matches", "m200").has_value());
+    }
+
+    // Publishing through b lands in the grown table too
+    {
+        auto guard = b.lock();
+        b.publish("players", "p1", 7, 1);
+    }
+    EXPECT_EQ(a.find("players", "p1")->written, 7);
+}
+
+TEST_F(CacheTest, SharedIndexReadersNeverSeeTornUpdates) {
+    std::filesystem::create_directories(dir);
+    SharedIndex index(dir / "index.bin", 16, [](SharedIndex&) {});
+    {
+        auto guard = index.lock();
+        index.publish("matches", "m1", 0, 0);
+    }
+
+    // Every publish writes written == size; a torn read would mix two of them
+    std::atomic<bool> done = false;
+    std::thread writer([&] {
+        for (int i = 1; i <= 20000; ++i) {
+            auto guard = index.lock();
+            index.publish("matches", "m1", i, static_cast<std::uint64_t>(i));
+        }
+        done = true;
+    });
+    std::uint64_t last_seq = 0;
+    while (!done) {
+        auto entry = index.find("matches", "m1");
+        ASSERT_TRUE(entry.has_value());
+        ASSERT_EQ(static_cast<std::uint64_t>(entry->written), entry->size);
+        ASSERT_GE(entry->seq, last_seq);
+        last_seq = entry->seq;
+    }
+    writer.join();
+    EXPECT_EQ(index.find("matches", "m1")->size, 20000u);
+}
+
+TEST_F(CacheTest, AppendPlayerMatchesMergesWithoutDuplicates) {
+    Cache a(dir);
+    Cache b(dir);
+    a.append_player_matches("p1", {"m1", "m2"});
+    b.append_player_matches("p1", {"m2", "m3"});
+
+    auto ids = a.get_player_matches("p1");
+    ASSERT_TRUE(ids.has_value());
+    EXPECT_EQ(*ids, (std::vector<std::string>{"m1", "m2", "m3"}));
+}
+
+TEST_F(CacheTest, StatsCountHitsMissesAndBytes) {
+    Cache cache(dir);
+    cache.store_match("m1", {{"kills", 1}});
+    cache.get_match("m1");
+    cache.get_match("m1");
+    cache.get_match("missing");
+
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.namespaces.size(), 3u);
+    auto& matches = stats.namespaces[0];
+    EXPECT_EQ(matches.name, "matches");
+    EXPECT_EQ(matches.hits, 2u);
+    EXPECT_EQ(matches.misses, 1u);
+    EXPECT_EQ(matches.writes, 1u);
+    EXPECT_GT(matches.bytes_written, 0u);
+    EXPECT_EQ(matches.read_latency.samples, 3u);
+    EXPECT_DOUBLE_EQ(matches.hit_rate(), 2.0 / 3.0);
+}
+
+TEST_F(CacheTest, StatsCountTtlExpiry) {
+    {
+        Cache writer(dir);
+        writer.store_mmr_history("p1", nlohmann::json::array());
+    }
+    auto old = std::filesystem::file_time_type::clock::now() - std::chrono::hours(2);
+    std::filesystem::last_write_time(dir / "mmr_history" / "p1.json", old);
+    std::filesystem::remove(dir / "index.bin"); // rebuilt with the backdated mtime
+
+    Cache cache(dir);
+    EXPECT_FALSE(cache.get_mmr_history("p1").has_value());
+    auto& mmr = cache.stats().namespaces[1];
+    EXPECT_EQ(mmr.expired, 1u);
+    EXPECT_EQ(mmr.misses, 1u);
+}
+
+TEST(LatencyHistogram, PercentileReturnsBucketUpperBound) {
+    LatencyHistogram h;
+    h.buckets[3] = 90; // [4, 8) us
+    h.buckets[10] = 10; // [512, 1024) us
+    h.samples = 100;
+    EXPECT_EQ(h.percentile_us(0.5), 8u);
+    EXPECT_EQ(h.percentile_us(0.99), 1024u);
+}
+
+TEST_F(CacheTest, BundleRoundTripsIntoEmptyCache) {
+    std::filesystem::path bundle = "test_cache.bundle";
+    {
+        Cache source(dir / "source");
+        source.store_match("m1", {{"kills", 1}});
+        source.store_match("m2", {{"kills", 2}});
+        source.store_player_matches("p1", {"m1", "m2"});
+        auto exported = source.export_bundle(bundle);
+        ASSERT_TRUE(exported.has_value());
+        EXPECT_EQ(*exported, 3u);
+    }
+
+    Cache target(dir / "target");
+    target.store_player_matches("p1", {"m0"});
+    auto imported = target.import_bundle(bundle);
+    ASSERT_TRUE(imported.has_value());
+    EXPECT_EQ(*imported, 3u);
+
+    EXPECT_EQ((*target.get_match("m2"))["kills"], 2);
+    EXPECT_EQ(*target.get_player_matches("p1"), (std::vector<std::string>{"m0", "m1", "m2"}));
+    std::filesystem::remove(bundle);
+}
+
+TEST_F(CacheTest, ImportKeepsExistingRecords) {
+    std::filesystem::path bundle = "test_cache.bundle";
+    {
+        Cache source(dir / "source");
+        source.store_match("m1", {{"kills", 1}});
+        source.export_bundle(bundle);
+    }
+
+    Cache target(dir / "target");
+    target.store_match("m1", {{"kills", 9}});
+    EXPECT_EQ(*target.import_bundle(bundle), 0u);
+    EXPECT_EQ((*target.get_match("m1"))["kills"], 9);
+    std::filesystem::remove(bundle);
+}
+
+TEST_F(CacheTest, ImportReplacesOnlyOlderLocalRecords) {
+    std::filesystem::path bundle = "test_cache.bundle";
+    Cache target(dir);
+    target.store_match("m1", {{"kills", 1}});
+    target.store_match("m2", {{"kills", 2}});
+    target.store_player_matches("p1", {"m1", "m2"});
+
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    ASSERT_TRUE(write_bundle(bundle, {
+        {.ns = "matches", .key = "m1", .payload = R"({"kills":10})", .written = now + 3600},
+        {.ns = "matches", .key = "m2", .payload = R"({"kills":20})", .written = now - 3600},
+        {.ns = "players", .key = "p1", .payload = R"(["m2","m1"])", .written = now + 3600},
+    }));
+
+    // Only m1 is newer; p1 gains no ids, so it does not count
+    EXPECT_EQ(*target.import_bundle(bundle), 1u);
+    EXPECT_EQ((*target.get_match("m1"))["kills"], 10);
+    EXPECT_EQ((*target.get_match("m2"))["kills"], 2);
+    std::filesystem::remove(bundle);
+}
+
+TEST_F(CacheTest, AttachedBundleServesMisses) {
+    std::filesystem::path bundle = "test_cache.bundle";
+    {
+        Cache source(dir / "source");
+        source.store_match("m1", {{"kills", 1}});
+        source.export_bundle(bundle);
+    }
+
+    Cache cache(dir / "target");
+    EXPECT_FALSE(cache.get_match("m1").has_value());
+    ASSERT_TRUE(cache.attach_bundle(bundle));
+    auto m1 = cache.get_match("m1");
+    ASSERT_TRUE(m1.has_value());
+    EXPECT_EQ((*m1)["kills"], 1);
+    EXPECT_FALSE(cache.get_match("m2").has_value());
+    std::filesystem::remove(bundle);
+}
+
+TEST_F(CacheTest, RejectsInvalidBundle) {
+    std::filesystem::path bundle = "test_cache.bundle";
+    std::ofstream(bundle) << "not a bundle at all, just some text";
+
+    Cache cache(dir);
+    EXPECT_FALSE(cache.attach_bundle(bundle));
+    EXPECT_FALSE(cache.import_bundle(bundle).has_value());
+    std::filesystem::remove(bundle);
+}
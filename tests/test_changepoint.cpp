@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "valorant/changepoint.hpp"
+#include <cmath>
+#include <limits>
+
+using namespace valorant;
+using namespace std::chrono;
+
+namespace {
+
+// Deterministic noise in [-amplitude, amplitude]
+std::vector<double> noisy_steps(const std::vector<std::pair<int, double>>& steps,
+                                double amplitude) {
+    std::vector<double> values;
+    std::uint64_t x = 42;
+    for (auto [length, mean] : steps) {
+        for (int i = 0; i < length; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            double u = static_cast<double>(x >> 11) / static_cast<double>(1ULL << 53);
+            values.push_back(mean + amplitude * (2.0 * u - 1.0));
+        }
+    }
+    return values;
+}
+
+// Optimal partitioning without pruning: the answer PELT must reproduce
+double brute_force_cost(const std::vector<double>& v, int m, double penalty) {
+    int n = static_cast<int>(v.size());
+    auto cost = [&](int s, int t) {
+        double mean = 0.0;
+        for (int i = s; i < t; ++i) mean += v[i];
+        mean /= (t - s);
+        double c = 0.0;
+        for (int i = s; i < t; ++i) c += (v[i] - mean) * (v[i] - mean);
+        return c;
+    };
+    std::vector<double> best(n + 1, std::numeric_limits<double>::infinity());
+    best[0] = -penalty;
+    for (int t = m; t <= n; ++t) {
+        for (int s = 0; s + m <= t; ++s) {
+            if (s != 0 && s < m) continue;
+            best[t] = std::min(best[t], best[s] + cost(s, t) + penalty);
+        }
+    }
+    return best[n];
+}
+
+double segmentation_cost(const std::vector<double>& v, const std::vector<SeriesSegment>& segs,
+                         double penalty) {
+    double total = -penalty;
+    for (auto& s : segs) {
+        total += penalty;
+        for (int i = s.begin; i < s.end; ++i) total += (v[i] - s.mean) * (v[i] - s.mean);
+    }
+    return total;
+}
+
+} // namespace
+
+TEST(Changepoint, FindsMeanShifts) {
+    auto values = noisy_steps({{40, 1.0}, {40, 2.5}, {40, 0.8}}, 0.4);
+    auto segments = detect_changepoints(values);
+    ASSERT_EQ(segments.size(), 3u);
+    EXPECT_EQ(segments[0].begin, 0);
+    EXPECT_NEAR(segments[0].end, 40, 1);
+    EXPECT_NEAR(segments[1].end, 80, 1);
+    EXPECT_EQ(segments[2].end, 120);
+    EXPECT_NEAR(segments[1].mean, 2.5, 0.15);
+    EXPECT_NEAR(segments[2].mean, 0.8, 0.15);
+}
+
+TEST(Changepoint, StationaryNoiseIsOneSegment) {
+    auto values = noisy_steps({{300, 1.4}}, 0.6);
+    auto segments = detect_changepoints(values);
+    ASSERT_EQ(segments.size(), 1u);
+    EXPECT_EQ(segments[0].length(), 300);
+
+    EXPECT_TRUE(detect_changepoints(std::vector<double>{}).empty());
+    EXPECT_EQ(detect_changepoints(std::vector<double>(25, 3.0)).size(), 1u);
+}
+
+TEST(Changepoint, PruningKeepsTheOptimum) {
+    auto values = noisy_steps({{17, 0.5}, {9, 1.5}, {30, 1.0}, {12, 2.0}, {22, 0.7}}, 0.5);
+    ChangepointOptions options{.min_segment_length = 4, .penalty = 0.8};
+    auto segments = detect_changepoints(values, options);
+
+    int covered = 0;
+    for (auto& s : segments) {
+        EXPECT_EQ(s.begin, covered);
+        EXPECT_GE(s.length(), 4);
+        covered = s.end;
+    }
+    EXPECT_EQ(covered, static_cast<int>(values.size()));
+    EXPECT_NEAR(segmentation_cost(values, segments, 0.8), brute_force_cost(values, 4, 0.8), 1e-9);
+}
+
+TEST(Changepoint, TiltSeriesFromTable) {
+    std::vector<PlayerMatchSummary> matches;
+    auto t = system_clock::from_time_t(1700000000);
+    for (int i = 0; i < 90; ++i) {
+        PlayerMatchSummary m;
+        m.game_start = t + hours(i);
+        bool tilted = i >= 50;
+        m.kills = tilted ? 8 + i % 3 : 22 + i % 4;
+        m.deaths = tilted ? 16 : 10;
+        m.won = tilted ? i % 4 == 0 : i % 4 != 0;
+        m.rr_change = m.won ? 20 : -18;
+        m.rr_available = true;
+        matches.push_back(m);
+    }
+    auto tilt = detect_tilt(MatchTable::from_matches(matches));
+
+    ASSERT_EQ(tilt.kda.size(), 2u);
+    EXPECT_EQ(tilt.kda[1].begin, 50);
+    EXPECT_LT(tilt.kda[1].mean, 1.0);
+    ASSERT_FALSE(tilt.win_rate.empty());
+    EXPECT_EQ(tilt.win_rate.back().end, 90);
+    EXPECT_GT(tilt.win_rate.front().mean, tilt.win_rate.back().mean);
+    EXPECT_GT(tilt.rr.front().mean, 0.0);
+    EXPECT_LT(tilt.rr.back().mean, 0.0);
+}
+
+TEST(Changepoint, RrShiftsIgnoreMatchesWithoutRr) {
+    // Only the newest matches line up with the MMR history; the rest read 0
+    std::vector<PlayerMatchSummary> matches;
+    auto t = system_clock::from_time_t(1700000000);
+    for (int i = 0; i < 5000; ++i) {
+        PlayerMatchSummary m;
+        m.game_start = t + hours(i);
+        m.kills = 15 + i % 5;
+        m.deaths = 12;
+        m.won = i % 2 == 0;
+        if (i >= 4980) {
+            m.rr_change = m.won ? 21 : -17;
+            m.rr_available = true;
+        }
+        matches.push_back(m);
+    }
+    auto tilt = detect_tilt(MatchTable::from_matches(matches));
+
+    ASSERT_EQ(tilt.rr.size(), 1u);
+    EXPECT_EQ(tilt.rr[0].begin, 4980);
+    EXPECT_EQ(tilt.rr[0].end, 5000);
+    EXPECT_DOUBLE_EQ(tilt.rr[0].mean, 2.0);
+    ASSERT_EQ(tilt.rr_matches.size(), 20u);
+    EXPECT_EQ(tilt.rr_matches.front(), 4980);
+    EXPECT_EQ(tilt.rr_values.front(), 21.0);
+
+    for (auto& m : matches) m.rr_available = false;
+    EXPECT_TRUE(detect_tilt(MatchTable::from_matches(matches)).rr.empty());
+}
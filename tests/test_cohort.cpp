@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "valorant/analytics.hpp"
+#include "valorant/api_client.hpp"
+#include "valorant/cohort.hpp"
+#include "valorant/session_detector.hpp"
+#include <ctime>
+
+using namespace valorant;
+using namespace std::chrono;
+
+namespace {
+
+// `sessions` sessions of 2-5 games starting at `offset_hours`; kills fall
+// through each session and the agent alternates per session.
+std::vector<PlayerMatchSummary> make_player(int sessions, int offset_hours, int seed) {
+    std::vector<PlayerMatchSummary> matches;
+    auto t = system_clock::from_time_t(1700000000) + hours(offset_hours);
+    for (int s = 0; s < sessions; ++s) {
+        int len = 2 + (s + seed) % 4;
+        for (int g = 0; g < len; ++g) {
+            PlayerMatchSummary m;
+            m.match_id = MatchId::parse("cohort-" + std::to_string(seed) + "-" +
+                                        std::to_string(matches.size()));
+            m.game_start = t;
+            m.game_length_secs = 1800;
+            m.kills = 22 - 3 * g + (s * seed) % 5;
+            m.deaths = 10 + g;
+            m.won = (s + g + seed) % 2 == 0;
+            m.damage_made = 3000 - 100 * g;
+            m.rounds_played = 22;
+            m.agent_id = agent_names().intern(s % 2 ? "Sova" : "Viper");
+            m.map_id = map_names().intern((s + seed) % 3 ? "Lotus" : "Pearl");
+            matches.push_back(m);
+            t += minutes(35);
+        }
+        t += hours(14);
+    }
+    return matches;
+}
+
+// A match as the stored-matches endpoint returns it, playing on red
+nlohmann::json to_stored_json(const PlayerMatchSummary& m, const std::string& id) {
+    int ours = m.won ? 13 : 9;
+    auto start = system_clock::to_time_t(m.game_start);
+    std::tm tm{};
+    gmtime_r(&start, &tm);
+    char started_at[32];
+    std::strftime(started_at, sizeof(started_at), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    return {
+        {"meta", {
+            {"id", id},
+            {"map", {{"name", map_names().name(m.map_id)}}},
+            {"mode", "Competitive"},
+            {"started_at", started_at},
+        }},
+        {"stats", {
+            {"kills", m.kills},
+            {"deaths", m.deaths},
+            {"assists", m.assists},
+            {"score", m.score},
+            {"character", {{"name", agent_names().name(m.agent_id)}}},
+            {"team", "Red"},
+            {"damage", {{"made", m.damage_made}}},
+        }},
+        {"teams", {{"red", ours}, {"blue", 22 - ours}}},
+    };
+}
+
+} // namespace
+
+TEST(Cohort, SinglePlayerMatchesPerPlayerAnalyses) {
+    auto matches = make_player(20, 0, 3);
+    ThreadPool pool(2);
+    auto report = analyze_cohort({matches}, CohortOptions{}, pool);
+
+    auto table = MatchTable::from_matches(matches);
+    auto sessions = detect_sessions(table);
+    auto batch = aggregate_matches(table);
+    auto decay = decay_curve(table, sessions);
+
+    EXPECT_EQ(report.players, 1);
+    EXPECT_EQ(report.match_count, matches.size());
+    EXPECT_EQ(report.session_count, static_cast<int>(sessions.size()));
+    ASSERT_EQ(report.agents.size(), batch.agents.size());
+    for (size_t i = 0; i < batch.agents.size(); ++i) {
+        EXPECT_EQ(report.agents[i].agent, batch.agents[i].agent);
+        EXPECT_EQ(report.agents[i].avg_kda, batch.agents[i].avg_kda);
+        EXPECT_EQ(report.agents[i].kda_quantiles.p50, batch.agents[i].kda_quantiles.p50);
+    }
+    ASSERT_EQ(report.hourly.size(), batch.hourly.size());
+    EXPECT_EQ(report.decay.points, decay.points);
+    EXPECT_EQ(report.decay.slope, decay.slope);
+}
+
+TEST(Cohort, PoolsPlayersWithoutJoiningTheirSessions) {
+    // Overlapping timelines: pooled rows would merge into shared sessions
+    std::vector<std::vector<PlayerMatchSummary>> players = {
+        make_player(15, 0, 1), {}, make_player(12, 1, 2), make_player(9, 0, 5),
+    };
+
+    ThreadPool one(1), four(4);
+    auto report = analyze_cohort(players, CohortOptions{}, four);
+    auto serial = analyze_cohort(players, CohortOptions{}, one);
+
+    EXPECT_EQ(report.players, 3);
+    int sessions = 0;
+    std::int64_t qualifying_games = 0;
+    std::size_t matches = 0;
+    for (auto& p : players) {
+        matches += p.size();
+        for (auto& s : detect_sessions(p)) {
+            sessions++;
+            if (s.game_count() >= 3) qualifying_games += s.game_count();
+        }
+    }
+    EXPECT_EQ(report.match_count, matches);
+    EXPECT_EQ(report.session_count, sessions);
+
+    std::int64_t sampled = 0;
+    for (auto n : report.decay.sample_counts) sampled += n;
+    EXPECT_EQ(sampled, qualifying_games);
+    EXPECT_LT(report.decay.slope, 0.0);
+
+    EXPECT_EQ(report.decay.slope, serial.decay.slope);
+    ASSERT_EQ(report.maps.size(), serial.maps.size());
+    EXPECT_EQ(report.maps[0].avg_kda, serial.maps[0].avg_kda);
+    int games = 0;
+    for (auto& a : report.agents) games += a.games;
+    EXPECT_EQ(games, static_cast<int>(matches));
+}
+
+TEST(Cohort, CacheOverloadMatchesInMemoryPlayers) {
+    std::filesystem::path dir = "test_cohort_cache";
+    std::filesystem::remove_all(dir);
+
+    std::vector<std::string> puuids = {"p1", "p2", "unknown", "p3"};
+    std::vector<std::vector<PlayerMatchSummary>> players(puuids.size());
+    {
+        Cache writer(dir);
+        int seed = 1;
+        for (size_t p = 0; p < puuids.size(); ++p) {
+            if (puuids[p] == "unknown") continue;
+            std::vector<std::string> ids;
+            for (auto& m : make_player(10 + 2 * seed, seed, seed)) {
+                auto id = puuids[p] + "-" + std::to_string(ids.size());
+                auto json = to_stored_json(m, id);
+                writer.store_match(id, json);
+                players[p].push_back(parse_stored_match(json));
+                ids.push_back(id);
+            }
+            writer.store_player_matches(puuids[p], ids);
+            ++seed;
+        }
+    }
+
+    CohortOptions options{.gap_threshold = minutes(60), .min_session_length = 2};
+    ThreadPool pool(1); // fewer workers than players, so submissions are batched
+    Cache cache(dir, 4);
+    auto cached = analyze_cohort(cache, puuids, options, pool);
+    auto direct = analyze_cohort(players, options, pool);
+
+    EXPECT_EQ(cached.players, 3);
+    EXPECT_EQ(cached.match_count, direct.match_count);
+    EXPECT_EQ(cached.session_count, direct.session_count);
+    EXPECT_EQ(cached.decay.points, direct.decay.points);
+    EXPECT_EQ(cached.decay.slope, direct.decay.slope);
+    ASSERT_EQ(cached.agents.size(), direct.agents.size());
+    for (size_t i = 0; i < direct.agents.size(); ++i) {
+        EXPECT_EQ(cached.agents[i].agent, direct.agents[i].agent);
+        EXPECT_EQ(cached.agents[i].avg_kda, direct.agents[i].avg_kda);
+    }
+    ASSERT_EQ(cached.hourly.size(), direct.hourly.size());
+    for (size_t i = 0; i < direct.hourly.size(); ++i) {
+        EXPECT_EQ(cached.hourly[i].win_rate, direct.hourly[i].win_rate);
+    }
+
+    std::filesystem::remove_all(dir);
+}
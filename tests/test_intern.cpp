@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include "valorant/intern.hpp"
+#include <limits>
+#include <string>
+
+using namespace valorant;
+
+TEST(InternTable, EmptyStringIsZero) {
+    InternTable table;
+    EXPECT_EQ(table.intern(""), 0);
+    EXPECT_EQ(table.name(0), "");
+    EXPECT_EQ(table.size(), 1u);
+}
+
+TEST(InternTable, SameNameSameId) {
+    InternTable table;
+    auto jett = table.intern("Jett");
+    auto sova = table.intern("Sova");
+    EXPECT_NE(jett, sova);
+    EXPECT_EQ(table.intern("Jett"), jett);
+    EXPECT_EQ(table.name(sova), "Sova");
+    EXPECT_EQ(table.size(), 3u);
+}
+
+TEST(InternTable, FullTableReturnsEmptyId) {
+    InternTable table;
+    NameId last = 0;
+    while (table.size() <= std::numeric_limits<NameId>::max()) {
+        last = table.intern("name" + std::to_string(table.size()));
+    }
+    EXPECT_EQ(last, std::numeric_limits<NameId>::max());
+    EXPECT_EQ(table.intern("one too many"), 0);
+    EXPECT_EQ(table.intern("name1"), 1); // existing names keep their ids
+    EXPECT_EQ(table.size(), std::size_t{std::numeric_limits<NameId>::max()} + 1);
+}
+
+TEST(InternTable, UnknownIdResolvesToEmpty) {
+    InternTable table;
+    EXPECT_EQ(table.name(999), "");
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "valorant/local_time.hpp"
+#include <cstdlib>
+#include <ctime>
+#include <optional>
+#include <string>
+
+using namespace valorant;
+
+namespace {
+
+class LocalTimeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (auto* tz = ::getenv("TZ")) saved_tz_ = tz;
+    }
+
+    void TearDown() override {
+        if (saved_tz_) ::setenv("TZ", saved_tz_->c_str(), 1);
+        else ::unsetenv("TZ");
+        ::tzset();
+    }
+
+    void use_zone(const char* tz) {
+        ::setenv("TZ", tz, 1);
+        ::tzset();
+    }
+
+    static void expect_matches_localtime(LocalTimeCache& cache, std::int64_t t) {
+        auto tt = static_cast<std::time_t>(t);
+        std::tm tm{};
+        ASSERT_NE(localtime_r(&tt, &tm), nullptr);
+        auto local = cache.at(t);
+        EXPECT_EQ(local.hour, tm.tm_hour) << "t=" << t;
+        EXPECT_EQ(local.weekday, tm.tm_wday) << "t=" << t;
+    }
+
+private:
+    std::optional<std::string> saved_tz_;
+};
+
+} // namespace
+
+TEST_F(LocalTimeTest, MatchesLocaltimeAcrossDstTransitions) {
+    use_zone("America/New_York");
+    LocalTimeCache cache;
+    // 2024-03-08 .. 2024-03-12 and 2024-10-31 .. 2024-11-05, every 10 minutes
+    for (std::int64_t t = 1709856000; t < 1710201600; t += 600) expect_matches_localtime(cache, t);
+    for (std::int64_t t = 1730332800; t < 1730764800; t += 600) expect_matches_localtime(cache, t);
+}
+
+TEST_F(LocalTimeTest, HalfHourOffsetAndPreEpoch) {
+    use_zone("Asia/Kolkata");
+    LocalTimeCache cache;
+    for (std::int64_t t = -172800; t < 172800; t += 900) expect_matches_localtime(cache, t);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "valorant/match_id.hpp"
+#include <limits>
+#include <stdexcept>
+
+using namespace valorant;
+
+TEST(MatchId, UuidRoundTrips) {
+    auto id = MatchId::parse("3F2504E0-4f89-11d3-9a0c-0305e82c3301");
+    EXPECT_EQ(id.hi, 0x3f2504e04f8911d3ull);
+    EXPECT_EQ(id.lo, 0x9a0c0305e82c3301ull);
+    EXPECT_EQ(id.to_string(), "3f2504e0-4f89-11d3-9a0c-0305e82c3301");
+    EXPECT_EQ(MatchId::parse(id.to_string()), id);
+}
+
+TEST(MatchId, EmptyAndNonUuid) {
+    EXPECT_TRUE(MatchId::parse("").empty());
+    EXPECT_EQ(MatchId::parse("").to_string(), "");
+
+    auto a = MatchId::parse("match-1");
+    EXPECT_FALSE(a.empty());
+    EXPECT_EQ(a, MatchId::parse("match-1"));
+    EXPECT_NE(a, MatchId::parse("match-2"));
+    // Malformed UUIDs fall back to hashing rather than parsing partially
+    EXPECT_NE(MatchId::parse("3f2504e0-4f89-11d3-9a0c-0305e82c330g"),
+              MatchId::parse("3f2504e0-4f89-11d3-9a0c-0305e82c3300"));
+}
+
+TEST(MatchIdMap, InsertFindAndGrow) {
+    MatchIdMap<int> map;
+    for (int i = 0; i < 1000; ++i) {
+        auto [slot, inserted] = map.try_emplace(MatchId::parse("m" + std::to_string(i)), i);
+        ASSERT_TRUE(inserted);
+        ASSERT_EQ(*slot, i);
+    }
+    EXPECT_EQ(map.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        auto* v = map.find(MatchId::parse("m" + std::to_string(i)));
+        ASSERT_NE(v, nullptr);
+        EXPECT_EQ(*v, i);
+    }
+    EXPECT_EQ(map.find(MatchId::parse("missing")), nullptr);
+
+    map.insert_or_assign(MatchId::parse("m7"), -7);
+    EXPECT_EQ(*map.find(MatchId::parse("m7")), -7);
+    EXPECT_EQ(map.size(), 1000u);
+
+    EXPECT_FALSE(map.try_emplace(MatchId{}).second);
+    EXPECT_FALSE(map.contains(MatchId{}));
+}
+
+TEST(MatchIdMap, HugeReserveFailsInsteadOfHanging) {
+    MatchIdMap<bool> map;
+    EXPECT_THROW(map.reserve(std::numeric_limits<std::size_t>::max()), std::length_error);
+    EXPECT_TRUE(map.empty());
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "valorant/match_kernels.hpp"
+#include "valorant/types.hpp"
+#include <vector>
+
+using namespace valorant;
+
+namespace {
+
+// Lengths around the 4-wide vector width exercise both the SIMD body and the tail
+constexpr std::size_t lengths[] = {0, 1, 3, 4, 5, 8, 11, 64, 67};
+
+} // namespace
+
+TEST(MatchKernels, KdaMatchesScalarDefinition) {
+    for (auto n : lengths) {
+        std::vector<std::int32_t> kills(n), deaths(n), assists(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            kills[i] = static_cast<std::int32_t>(i * 7 % 31);
+            deaths[i] = static_cast<std::int32_t>(i % 4 == 0 ? 0 : i * 3 % 19);
+            assists[i] = static_cast<std::int32_t>(i % 9);
+        }
+        std::vector<double> out(n, -1.0);
+        kda_column(kills.data(), deaths.data(), assists.data(), out.data(), n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            PlayerMatchSummary m;
+            m.kills = kills[i];
+            m.deaths = deaths[i];
+            m.assists = assists[i];
+            EXPECT_EQ(out[i], m.kda()) << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST(MatchKernels, DprZeroRoundsIsZero) {
+    for (auto n : lengths) {
+        std::vector<std::int32_t> damage(n), rounds(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            damage[i] = static_cast<std::int32_t>(1000 + i * 97);
+            rounds[i] = static_cast<std::int32_t>(i % 3 == 1 ? 0 : 13 + i % 12);
+        }
+        std::vector<double> out(n, -1.0);
+        dpr_column(damage.data(), rounds.data(), out.data(), n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            PlayerMatchSummary m;
+            m.damage_made = damage[i];
+            m.rounds_played = rounds[i];
+            EXPECT_EQ(out[i], m.damage_per_round()) << "n=" << n << " i=" << i;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "valorant/analytics.hpp"
+#include "valorant/arena.hpp"
+#include "valorant/match_table.hpp"
+
+using namespace valorant;
+using namespace std::chrono;
+
+namespace {
+
+std::vector<PlayerMatchSummary> make_matches(int count) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < count; ++i) {
+        PlayerMatchSummary m;
+        m.match_id = MatchId::parse("match-" + std::to_string(i));
+        m.game_start = system_clock::from_time_t(1700000000) + hours(i);
+        m.game_length_secs = 2000 + i;
+        m.kills = 10 + i % 7;
+        m.deaths = i % 5;
+        m.assists = i % 3;
+        m.score = 200 + i;
+        m.damage_made = 2500 + 10 * i;
+        m.rounds_played = i % 11 == 0 ? 0 : 20 + i % 5;
+        m.won = i % 3 != 0;
+        m.rr_change = m.won ? 18 : -15;
+        m.rr_available = i % 4 != 0;
+        m.agent_id = agent_names().intern(i % 2 ? "Jett" : "Omen");
+        m.map_id = map_names().intern(i % 3 ? "Ascent" : "Lotus");
+        matches.push_back(m);
+    }
+    return matches;
+}
+
+} // namespace
+
+TEST(MatchTable, RowsRoundTrip) {
+    auto matches = make_matches(130); // spans several bitset words
+    auto table = MatchTable::from_matches(matches);
+    ASSERT_EQ(table.size(), matches.size());
+
+    for (size_t i = 0; i < matches.size(); ++i) {
+        auto row = table.row(i);
+        EXPECT_EQ(row.match_id, matches[i].match_id);
+        EXPECT_EQ(row.game_start, matches[i].game_start);
+        EXPECT_EQ(row.won, matches[i].won);
+        EXPECT_EQ(row.rr_available, matches[i].rr_available);
+        EXPECT_EQ(row.agent_id, matches[i].agent_id);
+        EXPECT_DOUBLE_EQ(table.kda(i), matches[i].kda());
+        EXPECT_DOUBLE_EQ(table.damage_per_round(i), matches[i].damage_per_round());
+    }
+}
+
+TEST(MatchTable, EmptyInput) {
+    auto table = MatchTable::from_matches({});
+    EXPECT_TRUE(table.empty());
+    EXPECT_TRUE(performance_by_agent(table).empty());
+}
+
+TEST(MatchTable, AnalyticsMatchVectorOverloads) {
+    auto matches = make_matches(60);
+    auto table = MatchTable::from_matches(matches);
+
+    auto agents = performance_by_agent(table);
+    auto maps = performance_by_map(table);
+    auto overview = compute_overview(table, agents, maps);
+    auto expected = compute_overview(matches, performance_by_agent(matches),
+                                     performance_by_map(matches));
+
+    EXPECT_EQ(overview.wins, expected.wins);
+    EXPECT_EQ(overview.total_kills, expected.total_kills);
+    EXPECT_EQ(overview.longest_loss_streak, expected.longest_loss_streak);
+    EXPECT_DOUBLE_EQ(overview.avg_damage_per_round, expected.avg_damage_per_round);
+    EXPECT_EQ(overview.best_agent, expected.best_agent);
+    EXPECT_EQ(rolling_kda(table, 7).size(), rolling_kda(matches, 7).size());
+}
+
+TEST(MatchTable, AllocatesFromArena) {
+    Arena arena;
+    auto matches = make_matches(20);
+    auto table = MatchTable::from_matches(matches, arena.resource());
+    EXPECT_EQ(table.resource(), arena.resource());
+    EXPECT_EQ(table.agent_id.get_allocator().resource(), arena.resource());
+
+    std::vector<Session> sessions = {{.index = 0, .begin = 0, .end = 12},
+                                     {.index = 1, .begin = 12, .end = 20}};
+    auto result = performance_by_session(table, sessions);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[1].games.size(), 8u);
+    EXPECT_EQ(result[1].games.get_allocator().resource(), arena.resource());
+}
+
+TEST(MatchTable, LocalTimeColumns) {
+    auto matches = make_matches(48);
+    auto table = MatchTable::from_matches(matches);
+    for (size_t i = 0; i < matches.size(); ++i) {
+        auto tt = system_clock::to_time_t(matches[i].game_start);
+        std::tm tm{};
+        localtime_r(&tt, &tm);
+        EXPECT_EQ(table.local_hour[i], tm.tm_hour);
+        EXPECT_EQ(table.local_weekday[i], tm.tm_wday);
+    }
+}
+
+TEST(MatchTable, AggregatesMatchIndividualAnalyses) {
+    auto matches = make_matches(150);
+    auto table = MatchTable::from_matches(matches);
+    auto fused = aggregate_matches(table, 9);
+
+    auto agents = performance_by_agent(table);
+    auto maps = performance_by_map(table);
+    auto overview = compute_overview(table, agents, maps);
+    auto hourly = performance_by_hour(table);
+
+    ASSERT_EQ(fused.agents.size(), agents.size());
+    for (size_t i = 0; i < agents.size(); ++i) {
+        EXPECT_EQ(fused.agents[i].agent, agents[i].agent);
+        EXPECT_EQ(fused.agents[i].avg_kda, agents[i].avg_kda);
+        EXPECT_EQ(fused.agents[i].avg_damage_per_round, agents[i].avg_damage_per_round);
+    }
+    ASSERT_EQ(fused.maps.size(), maps.size());
+    EXPECT_EQ(fused.maps[0].avg_score, maps[0].avg_score);
+    ASSERT_EQ(fused.hourly.size(), hourly.size());
+    for (size_t i = 0; i < hourly.size(); ++i) {
+        EXPECT_EQ(fused.hourly[i].hour, hourly[i].hour);
+        EXPECT_EQ(fused.hourly[i].avg_kda, hourly[i].avg_kda);
+    }
+
+    EXPECT_EQ(fused.overview.wins, overview.wins);
+    EXPECT_EQ(fused.overview.total_rr, overview.total_rr);
+    EXPECT_EQ(fused.overview.avg_damage_per_round, overview.avg_damage_per_round);
+    EXPECT_EQ(fused.overview.current_streak, overview.current_streak);
+    EXPECT_EQ(fused.overview.best_agent, overview.best_agent);
+    EXPECT_EQ(fused.overview.worst_map, overview.worst_map);
+
+    auto kda = rolling_kda(table, 9);
+    auto wr = rolling_win_rate(table, 9);
+    EXPECT_EQ(fused.rolling_kda.first_index, kda.first_index);
+    EXPECT_TRUE(std::ranges::equal(fused.rolling_kda, kda));
+    EXPECT_TRUE(std::ranges::equal(fused.rolling_wr, wr));
+}
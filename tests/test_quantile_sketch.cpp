@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "valorant/quantile_sketch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace valorant;
+
+namespace {
+
+// Deterministic, skewed values in [0, 10): most games near the low end
+std::vector<double> skewed(int n) {
+    std::vector<double> values;
+    std::uint64_t x = 12345;
+    for (int i = 0; i < n; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        double u = static_cast<double>(x >> 11) / static_cast<double>(1ULL << 53);
+        values.push_back(10.0 * u * u);
+    }
+    return values;
+}
+
+double exact_quantile(std::vector<double> values, double q) {
+    std::ranges::sort(values);
+    return values[static_cast<size_t>(q * (values.size() - 1))];
+}
+
+} // namespace
+
+TEST(QuantileSketch, EmptyAndSmallInputsAreExact) {
+    QuantileSketch sketch;
+    EXPECT_TRUE(sketch.empty());
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 0.0);
+
+    for (double v : {5.0, 1.0, 3.0, 4.0, 2.0}) sketch.add(v);
+    EXPECT_DOUBLE_EQ(sketch.count(), 5.0);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.0), 1.0);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 3.0);
+    EXPECT_DOUBLE_EQ(sketch.quantile(1.0), 5.0);
+}
+
+TEST(QuantileSketch, TracksLargeStreamInBoundedError) {
+    auto values = skewed(50000);
+    QuantileSketch sketch;
+    for (double v : values) sketch.add(v);
+
+    for (double q : {0.1, 0.5, 0.9}) {
+        EXPECT_NEAR(sketch.quantile(q), exact_quantile(values, q), 0.05) << "q=" << q;
+    }
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.0), *std::ranges::min_element(values));
+    EXPECT_DOUBLE_EQ(sketch.quantile(1.0), *std::ranges::max_element(values));
+}
+
+TEST(QuantileSketch, MergedPartsMatchWhole) {
+    auto values = skewed(20000);
+    QuantileSketch whole;
+    std::vector<QuantileSketch> parts(4);
+    for (size_t i = 0; i < values.size(); ++i) {
+        whole.add(values[i]);
+        parts[i % parts.size()].add(values[i]);
+    }
+
+    QuantileSketch merged;
+    for (auto& part : parts) merged.merge(part);
+    EXPECT_DOUBLE_EQ(merged.count(), whole.count());
+    for (double q : {0.1, 0.5, 0.9}) {
+        EXPECT_NEAR(merged.quantile(q), whole.quantile(q), 0.05) << "q=" << q;
+    }
+}
+
+TEST(QuantileSketch, QueryingDoesNotChangeLaterResults) {
+    auto values = skewed(3000);
+    QuantileSketch queried, untouched;
+    for (size_t i = 0; i < values.size(); ++i) {
+        queried.add(values[i]);
+        untouched.add(values[i]);
+        if (i % 97 == 0) queried.quantile(0.5);
+    }
+    EXPECT_EQ(queried.quantile(0.1), untouched.quantile(0.1));
+    EXPECT_EQ(queried.quantile(0.9), untouched.quantile(0.9));
+}
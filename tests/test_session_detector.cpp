@@ -8,7 +8,7 @@ namespace {
 
 PlayerMatchSummary make_match_at(int minute_offset, int duration_secs = 2400) {
     PlayerMatchSummary m;
-    m.match_id = "match-" + std::to_string(minute_offset);
+    m.match_id = MatchId::parse("match-" + std::to_string(minute_offset));
     m.game_start = system_clock::from_time_t(1700000000) + minutes(minute_offset);
     m.game_length_secs = duration_secs;
     m.kills = 15;
@@ -20,7 +20,7 @@ PlayerMatchSummary make_match_at(int minute_offset, int duration_secs = 2400) {
 } // namespace
 
 TEST(SessionDetector, EmptyInput) {
-    auto result = detect_sessions({});
+    auto result = detect_sessions(std::vector<PlayerMatchSummary>{});
     EXPECT_TRUE(result.empty());
 }
 
@@ -108,3 +108,23 @@ TEST(SessionDetector, TotalMatchCountPreserved) {
     for (auto& s : result) total += s.game_count();
     EXPECT_EQ(total, 20);
 }
+
+TEST(SessionDetector, TableMatchesVectorRanges) {
+    std::vector<PlayerMatchSummary> matches;
+    for (int i = 0; i < 12; ++i) {
+        matches.push_back(make_match_at(i * (i % 3 == 0 ? 120 : 45)));
+    }
+
+    auto from_vector = detect_sessions(matches, minutes(45));
+    auto from_table = detect_sessions(MatchTable::from_matches(matches), minutes(45));
+    ASSERT_EQ(from_vector.size(), from_table.size());
+
+    int expected_begin = 0;
+    for (size_t i = 0; i < from_table.size(); ++i) {
+        EXPECT_EQ(from_table[i].begin, expected_begin);
+        EXPECT_EQ(from_table[i].begin, from_vector[i].begin);
+        EXPECT_EQ(from_table[i].end, from_vector[i].end);
+        expected_begin = from_table[i].end;
+    }
+    EXPECT_EQ(expected_begin, 12);
+}